@@ -0,0 +1,76 @@
+#include <algorithm>
+#include "usermanager.h"
+
+// Publish a new admin view if any user changed since the last one.
+//
+// Writers only queue user IDs (UserShard::dirtyUsers). Here each shard is locked
+// just long enough to copy its queued users into fresh UserSummary objects; the
+// merge with the previous version and every later read run without writer locks.
+// Every mutation touches a single user, so each summary is a state that user
+// really had, and the totals are summed from the summaries themselves.
+shared_ptr<const AdminView> UserManager::adminView() const
+{
+    OP_TIMER(Op::AdminView);
+    lock_guard<mutex> rebuild(viewLock);
+    shared_ptr<const AdminView> previous = atomic_load(&currentView);
+
+    // (userId, new summary or null when the user was removed), in queue order per shard
+    vector<pair<int, shared_ptr<const UserSummary>>> updates;
+    for (const auto& shard : shards)
+    {
+        lock_guard<mutex> guard(shard->lock);
+        for (int id : shard->dirtyUsers)
+        {
+            User* found = shard->users.find(id);
+            if (!found)
+            {
+                updates.push_back({ id, nullptr });
+                continue;
+            }
+
+            User& user = *found;
+            if (!user.viewDirty) continue;              // Already copied earlier in this loop
+            user.viewDirty = false;
+            updates.push_back({ id, make_shared<const UserSummary>(UserSummary{
+                user.id, user.username, user.email, user.isActive,
+                static_cast<int>(user.tasks.size()), user.completedCount }) });
+        }
+        shard->dirtyUsers.clear();
+    }
+
+    if (updates.empty()) return previous;
+
+    // Latest update per ID wins (a user can be removed and restored between views)
+    stable_sort(updates.begin(), updates.end(), [](const auto& a, const auto& b)
+    {
+        return a.first < b.first;
+    });
+
+    auto next = make_shared<AdminView>();
+    next->version = previous->version + 1;
+    next->users.reserve(previous->users.size() + updates.size());
+
+    auto keep = [&](const shared_ptr<const UserSummary>& summary)
+    {
+        next->users.push_back(summary);
+        if (summary->isActive) next->activeUsers++;
+        next->totalTasks += summary->taskCount;
+        next->completedTasks += summary->completedCount;
+    };
+
+    auto old = previous->users.begin();
+    for (size_t u = 0; u < updates.size(); u++)
+    {
+        if (u + 1 < updates.size() && updates[u + 1].first == updates[u].first) continue;
+        int id = updates[u].first;
+
+        for (; old != previous->users.end() && (*old)->id < id; ++old) keep(*old);
+        if (old != previous->users.end() && (*old)->id == id) ++old; // Replaced or removed
+        if (updates[u].second) keep(updates[u].second);
+    }
+    for (; old != previous->users.end(); ++old) keep(*old);
+
+    shared_ptr<const AdminView> published = move(next);
+    atomic_store(&currentView, published);
+    return published;
+}
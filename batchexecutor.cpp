@@ -0,0 +1,367 @@
+#include <cctype>
+#include <chrono>
+#include <vector>
+#include "batchexecutor.h"
+
+namespace
+{
+// Split a line into whitespace separated tokens; "quoted text" is one token
+bool tokenize(const string& line, vector<string>& tokens, string& error)
+{
+    size_t i = 0;
+    while (i < line.size())
+    {
+        while (i < line.size() && isspace(static_cast<unsigned char>(line[i]))) i++;
+        if (i >= line.size()) break;
+        if (line[i] == '#') break;
+
+        string token;
+        if (line[i] == '"')
+        {
+            size_t close = line.find('"', i + 1);
+            if (close == string::npos)
+            {
+                error = "unterminated quote";
+                return false;
+            }
+            token = line.substr(i + 1, close - i - 1);
+            i = close + 1;
+        }
+        else
+        {
+            size_t start = i;
+            while (i < line.size() && !isspace(static_cast<unsigned char>(line[i]))) i++;
+            token = line.substr(start, i - start);
+        }
+        tokens.push_back(token);
+    }
+    return true;
+}
+
+// Strict integer parse - the whole token must be a number
+bool parseInt(const string& token, int& value)
+{
+    if (token.empty()) return false;
+    size_t used = 0;
+    try
+    {
+        value = stoi(token, &used);
+    }
+    catch (...)
+    {
+        return false;
+    }
+    return used == token.size();
+}
+
+// Visitor that forwards each typed request to the matching headless operation
+struct RequestRunner
+{
+    UserManager& um;
+
+    CommandResponse operator()(const RegisterUserRequest& r) const
+    {
+        CommandResponse resp;
+        resp.status = um.registerUser(r.username, r.email, r.password, &resp.userId);
+        return resp;
+    }
+
+    CommandResponse operator()(const LoginRequest& r) const
+    {
+        CommandResponse resp;
+        resp.status = um.loginUser(r.username, r.password, &resp.userId);
+        return resp;
+    }
+
+    CommandResponse operator()(const AddTaskRequest& r) const
+    {
+        CommandResponse resp;
+        resp.userId = r.userId;
+        resp.status = um.createTask(r.userId, r.title, r.dueDate, &resp.taskId);
+        return resp;
+    }
+
+    CommandResponse operator()(const EditTaskTitleRequest& r) const
+    {
+        return { um.setTaskTitle(r.userId, r.taskId, r.title), r.userId, r.taskId };
+    }
+
+    CommandResponse operator()(const EditTaskDueDateRequest& r) const
+    {
+        return { um.setTaskDueDate(r.userId, r.taskId, r.dueDate), r.userId, r.taskId };
+    }
+
+    CommandResponse operator()(const SetTaskStatusRequest& r) const
+    {
+        return { um.setTaskStatus(r.userId, r.taskId, r.status), r.userId, r.taskId };
+    }
+
+    CommandResponse operator()(const CompleteTaskRequest& r) const
+    {
+        return { um.completeTask(r.userId, r.taskId), r.userId, r.taskId };
+    }
+
+    CommandResponse operator()(const DeleteTaskRequest& r) const
+    {
+        return { um.removeTask(r.userId, r.taskId), r.userId, r.taskId };
+    }
+
+    CommandResponse operator()(const ToggleUserRequest& r) const
+    {
+        return { um.setUserActive(r.userId, !um.isUserActiveById(r.userId)), r.userId, 0 };
+    }
+
+    CommandResponse operator()(const ChangeUsernameRequest& r) const
+    {
+        return { um.changeUsername(r.userId, r.username), r.userId, 0 };
+    }
+
+    CommandResponse operator()(const ChangeEmailRequest& r) const
+    {
+        return { um.changeEmail(r.userId, r.email), r.userId, 0 };
+    }
+
+    CommandResponse operator()(const ChangePasswordRequest& r) const
+    {
+        return { um.changePassword(r.userId, r.currentPassword, r.newPassword), r.userId, 0 };
+    }
+
+    CommandResponse operator()(const DeleteUserRequest& r) const
+    {
+        return { um.removeUser(r.userId), r.userId, 0 };
+    }
+
+    CommandResponse operator()(const SearchUsersRequest& r) const
+    {
+        CommandResponse resp;
+        vector<int> matches = um.findUsersMatching(r.keyword, 1);
+        if (matches.empty()) resp.status = OpStatus::UserNotFound;
+        else resp.userId = matches.front();
+        return resp;
+    }
+
+    CommandResponse operator()(const SaveRequest& r) const
+    {
+        CommandResponse resp;
+        if (!um.saveToFile(r.filename)) resp.status = OpStatus::IoError;
+        return resp;
+    }
+
+    CommandResponse operator()(const LoadRequest& r) const
+    {
+        CommandResponse resp;
+        if (!um.loadFromFile(r.filename)) resp.status = OpStatus::IoError;
+        return resp;
+    }
+
+    CommandResponse operator()(const SaveSnapshotRequest& r) const
+    {
+        CommandResponse resp;
+        if (!um.saveSnapshot(r.filename)) resp.status = OpStatus::IoError;
+        return resp;
+    }
+
+    CommandResponse operator()(const LoadSnapshotRequest& r) const
+    {
+        CommandResponse resp;
+        if (!um.loadSnapshot(r.filename)) resp.status = OpStatus::IoError;
+        return resp;
+    }
+
+    CommandResponse operator()(const CheckpointRequest& r) const
+    {
+        CommandResponse resp;
+        if (!um.checkpoint(r.snapshotFile)) resp.status = OpStatus::IoError;
+        return resp;
+    }
+};
+}
+
+CommandResponse BatchExecutor::execute(const CommandRequest& request)
+{
+    return visit(RequestRunner{manager}, request);
+}
+
+bool BatchExecutor::parseCommand(const string& line, CommandRequest& request, string& error)
+{
+    error.clear();
+
+    vector<string> t;
+    if (!tokenize(line, t, error)) return false;
+    if (t.empty()) return false; // Blank or comment line
+
+    const string& cmd = t[0];
+    size_t argc = t.size() - 1;
+    int userId = 0, taskId = 0;
+
+    // Argument count and id checks shared by most commands
+    auto expect = [&](size_t count) {
+        if (argc != count)
+        {
+            error = cmd + ": expected " + to_string(count) + " argument(s)";
+            return false;
+        }
+        return true;
+    };
+    auto ids = [&](bool withTask) {
+        if (!parseInt(t[1], userId))
+        {
+            error = cmd + ": invalid user id '" + t[1] + "'";
+            return false;
+        }
+        if (withTask && !parseInt(t[2], taskId))
+        {
+            error = cmd + ": invalid task id '" + t[2] + "'";
+            return false;
+        }
+        return true;
+    };
+
+    if (cmd == "register")
+    {
+        if (!expect(3)) return false;
+        request = RegisterUserRequest{t[1], t[2], t[3]};
+    }
+    else if (cmd == "login")
+    {
+        if (!expect(2)) return false;
+        request = LoginRequest{t[1], t[2]};
+    }
+    else if (cmd == "add-task")
+    {
+        if (!expect(3) || !ids(false)) return false;
+        request = AddTaskRequest{userId, t[2], t[3]};
+    }
+    else if (cmd == "edit-title")
+    {
+        if (!expect(3) || !ids(true)) return false;
+        request = EditTaskTitleRequest{userId, taskId, t[3]};
+    }
+    else if (cmd == "edit-due")
+    {
+        if (!expect(3) || !ids(true)) return false;
+        request = EditTaskDueDateRequest{userId, taskId, t[3]};
+    }
+    else if (cmd == "set-status")
+    {
+        if (!expect(3) || !ids(true)) return false;
+        request = SetTaskStatusRequest{userId, taskId, t[3]};
+    }
+    else if (cmd == "complete")
+    {
+        if (!expect(2) || !ids(true)) return false;
+        request = CompleteTaskRequest{userId, taskId};
+    }
+    else if (cmd == "delete-task")
+    {
+        if (!expect(2) || !ids(true)) return false;
+        request = DeleteTaskRequest{userId, taskId};
+    }
+    else if (cmd == "toggle-user")
+    {
+        if (!expect(1) || !ids(false)) return false;
+        request = ToggleUserRequest{userId};
+    }
+    else if (cmd == "change-username")
+    {
+        if (!expect(2) || !ids(false)) return false;
+        request = ChangeUsernameRequest{userId, t[2]};
+    }
+    else if (cmd == "change-email")
+    {
+        if (!expect(2) || !ids(false)) return false;
+        request = ChangeEmailRequest{userId, t[2]};
+    }
+    else if (cmd == "change-password")
+    {
+        if (!expect(3) || !ids(false)) return false;
+        request = ChangePasswordRequest{userId, t[2], t[3]};
+    }
+    else if (cmd == "delete-user")
+    {
+        if (!expect(1) || !ids(false)) return false;
+        request = DeleteUserRequest{userId};
+    }
+    else if (cmd == "search")
+    {
+        if (!expect(1)) return false;
+        request = SearchUsersRequest{t[1]};
+    }
+    else if (cmd == "save")
+    {
+        if (!expect(1)) return false;
+        request = SaveRequest{t[1]};
+    }
+    else if (cmd == "load")
+    {
+        if (!expect(1)) return false;
+        request = LoadRequest{t[1]};
+    }
+    else if (cmd == "save-snapshot")
+    {
+        if (!expect(1)) return false;
+        request = SaveSnapshotRequest{t[1]};
+    }
+    else if (cmd == "load-snapshot")
+    {
+        if (!expect(1)) return false;
+        request = LoadSnapshotRequest{t[1]};
+    }
+    else if (cmd == "checkpoint")
+    {
+        if (!expect(1)) return false;
+        request = CheckpointRequest{t[1]};
+    }
+    else
+    {
+        error = "unknown command '" + cmd + "'";
+        return false;
+    }
+    return true;
+}
+
+BatchSummary BatchExecutor::run(istream& in, ostream& out, bool echoResults)
+{
+    BatchSummary summary;
+    auto start = chrono::steady_clock::now();
+
+    string line, error;
+    int lineNo = 0;
+    CommandRequest request;
+
+    while (getline(in, line))
+    {
+        lineNo++;
+        if (!parseCommand(line, request, error))
+        {
+            if (!error.empty())
+            {
+                summary.parseErrors++;
+                out << "ERR " << lineNo << " " << error << '\n';
+            }
+            continue;
+        }
+
+        CommandResponse resp = execute(request);
+        summary.executed++;
+        if (resp.ok())
+        {
+            summary.succeeded++;
+            if (echoResults)
+            {
+                out << "OK " << lineNo;
+                if (resp.userId) out << " user=" << resp.userId;
+                if (resp.taskId) out << " task=" << resp.taskId;
+                out << '\n';
+            }
+        }
+        else
+        {
+            summary.failed++;
+            out << "ERR " << lineNo << " " << opStatusMessage(resp.status) << '\n';
+        }
+    }
+
+    summary.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return summary;
+}
@@ -0,0 +1,170 @@
+#ifndef BATCH_EXECUTOR_H
+#define BATCH_EXECUTOR_H
+
+#include <iostream>
+#include <string>
+#include <variant>
+#include "usermanager.h"
+using namespace std;
+
+// Typed requests for the headless command layer - one struct per operation
+struct RegisterUserRequest {
+    string username;
+    string email;
+    string password;
+};
+
+struct LoginRequest {
+    string username;
+    string password;
+};
+
+struct AddTaskRequest {
+    int userId = 0;
+    string title;
+    string dueDate;
+};
+
+struct EditTaskTitleRequest {
+    int userId = 0;
+    int taskId = 0;
+    string title;
+};
+
+struct EditTaskDueDateRequest {
+    int userId = 0;
+    int taskId = 0;
+    string dueDate;
+};
+
+struct SetTaskStatusRequest {
+    int userId = 0;
+    int taskId = 0;
+    string status;
+};
+
+struct CompleteTaskRequest {
+    int userId = 0;
+    int taskId = 0;
+};
+
+struct DeleteTaskRequest {
+    int userId = 0;
+    int taskId = 0;
+};
+
+struct ToggleUserRequest {
+    int userId = 0;
+};
+
+struct ChangeUsernameRequest {
+    int userId = 0;
+    string username;
+};
+
+struct ChangeEmailRequest {
+    int userId = 0;
+    string email;
+};
+
+struct ChangePasswordRequest {
+    int userId = 0;
+    string currentPassword;
+    string newPassword;
+};
+
+struct DeleteUserRequest {
+    int userId = 0;
+};
+
+struct SearchUsersRequest {
+    string keyword;
+};
+
+struct SaveRequest {
+    string filename;
+};
+
+struct LoadRequest {
+    string filename;
+};
+
+struct SaveSnapshotRequest {
+    string filename;
+};
+
+struct LoadSnapshotRequest {
+    string filename;
+};
+
+struct CheckpointRequest {
+    string snapshotFile;
+};
+
+using CommandRequest = variant<
+    RegisterUserRequest, LoginRequest, AddTaskRequest, EditTaskTitleRequest,
+    EditTaskDueDateRequest, SetTaskStatusRequest, CompleteTaskRequest, DeleteTaskRequest,
+    ToggleUserRequest, ChangeUsernameRequest, ChangeEmailRequest, ChangePasswordRequest,
+    DeleteUserRequest, SearchUsersRequest, SaveRequest, LoadRequest, SaveSnapshotRequest, LoadSnapshotRequest,
+    CheckpointRequest>;
+
+// Result of one command - ids are filled in when the command creates or finds them
+struct CommandResponse {
+    OpStatus status = OpStatus::Ok;
+    int userId = 0;
+    int taskId = 0;
+
+    bool ok() const { return status == OpStatus::Ok; }
+};
+
+// Totals for one batch run
+struct BatchSummary {
+    int executed = 0;
+    int succeeded = 0;
+    int failed = 0;
+    int parseErrors = 0;
+    double seconds = 0.0;
+};
+
+// Runs commands against a UserManager without any console prompts.
+//
+// Script format - one command per line, '#' starts a comment, titles with
+// spaces go in double quotes:
+//   register <username> <email> <password>
+//   login <username> <password>
+//   add-task <userId> "<title>" <DD/MM/YYYY>
+//   edit-title <userId> <taskId> "<title>"
+//   edit-due <userId> <taskId> <DD/MM/YYYY>
+//   set-status <userId> <taskId> Ongoing|Completed
+//   complete <userId> <taskId>
+//   delete-task <userId> <taskId>
+//   toggle-user <userId>
+//   change-username <userId> <username>
+//   change-email <userId> <email>
+//   change-password <userId> <current> <new>
+//   delete-user <userId>
+//   search <keyword>           (admin user search; reports the best match)
+//   save <file>                (text format)
+//   load <file>
+//   save-snapshot <file>       (binary snapshot)
+//   load-snapshot <file>
+//   checkpoint <file>          (snapshot, then empty the attached journal)
+class BatchExecutor {
+private:
+    UserManager& manager;
+
+public:
+    explicit BatchExecutor(UserManager& um) : manager(um) {}
+
+    // Execute one typed request
+    CommandResponse execute(const CommandRequest& request);
+
+    // Parse one script line; returns false and sets error on bad input.
+    // Blank and comment lines parse to false with an empty error.
+    static bool parseCommand(const string& line, CommandRequest& request, string& error);
+
+    // Execute every line of a script, writing one result line per command
+    BatchSummary run(istream& in, ostream& out, bool echoResults = true);
+};
+
+#endif
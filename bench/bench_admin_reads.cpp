@@ -0,0 +1,157 @@
+// Writer tail latency while admin reports scan continuously:
+// no readers, readers holding every lock (saveToFile), readers on AdminView (the admin listings)
+//
+// Build: g++ -std=c++17 -O2 -pthread -o bench_admin_reads bench/bench_admin_reads.cpp usermanager.cpp snapshot.cpp parallelload.cpp journal.cpp dateutil.cpp taskcolumns.cpp trigramindex.cpp adminview.cpp identityindex.cpp tablerenderer.cpp opmetrics.cpp bulkimport.cpp bulktasks.cpp terminal.cpp taskowners.cpp reminders.cpp blockcodec.cpp
+// Run:   ./bench_admin_reads --users 100000 --tasks 10 --ms 3000
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "bench_common.h"
+
+namespace
+{
+#ifdef _WIN32
+const char NULL_FILE[] = "NUL";
+#else
+const char NULL_FILE[] = "/dev/null";
+#endif
+
+class NullBuffer : public streambuf
+{
+protected:
+    int overflow(int c) override { return c; }
+    streamsize xsputn(const char*, streamsize n) override { return n; }
+};
+
+enum class ReaderKind { None, Locked, View };
+
+struct Result
+{
+    vector<double> latencyUs;
+    long long scans = 0;
+};
+
+// One writer doing task operations for `ms` milliseconds while one reader scans.
+// The reports print to the shared cout, which is why there is a single reader thread.
+Result runScenario(UserManager& um, int firstUserId, int users, int ms, ReaderKind kind)
+{
+    Result result;
+    atomic<bool> stop(false);
+    atomic<long long> scans(0);
+
+    vector<thread> pool;
+    if (kind != ReaderKind::None)
+    {
+        pool.emplace_back([&]()
+        {
+            while (!stop)
+            {
+                if (kind == ReaderKind::Locked)
+                {
+                    um.saveToFile(NULL_FILE);
+                }
+                else
+                {
+                    // The admin screens without their pager: every row in one page
+                    UserCursor users, counts;
+                    um.showAdminDashboard();
+                    um.writeUserPage(cout, users);
+                    um.writeTaskCountPage(cout, counts);
+                }
+                scans++;
+            }
+        });
+    }
+
+    mt19937 rng(99);
+    vector<pair<int, int>> owned;
+    BenchTimer total;
+    while (total.millis() < ms)
+    {
+        int userId = firstUserId + static_cast<int>(rng() % users);
+        BenchTimer op;
+        if (owned.empty() || rng() % 3 == 0)
+        {
+            int taskId = 0;
+            um.createTask(userId, "Writer task", benchDate(rng()), &taskId);
+            owned.push_back({ userId, taskId });
+        }
+        else if (rng() % 2 == 0)
+        {
+            const auto& t = owned[rng() % owned.size()];
+            um.completeTask(t.first, t.second);
+        }
+        else
+        {
+            size_t k = rng() % owned.size();
+            um.removeTask(owned[k].first, owned[k].second);
+            owned[k] = owned.back();
+            owned.pop_back();
+        }
+        result.latencyUs.push_back(op.seconds() * 1e6);
+    }
+
+    stop = true;
+    for (auto& th : pool)
+    {
+        th.join();
+    }
+    result.scans = scans;
+    return result;
+}
+
+double percentile(vector<double>& sorted, double p)
+{
+    if (sorted.empty()) return 0;
+    size_t index = min(sorted.size() - 1, static_cast<size_t>(p / 100.0 * sorted.size()));
+    return sorted[index];
+}
+}
+
+int main(int argc, char* argv[])
+{
+    int users = static_cast<int>(benchArg(argc, argv, "users", 100000));
+    int tasks = static_cast<int>(benchArg(argc, argv, "tasks", 10));
+    int ms = static_cast<int>(benchArg(argc, argv, "ms", 3000));
+    unsigned shards = static_cast<unsigned>(benchArg(argc, argv, "shards", 64));
+
+    // Reports print to cout - discard it for the whole run
+    NullBuffer nullBuffer;
+    streambuf* original = cout.rdbuf(&nullBuffer);
+    UserManager um(shards);
+    populateUsers(um, users, tasks);
+    int firstUserId = 106; // populateUsers registers after the 5 sample users (101-105)
+
+    struct Scenario
+    {
+        const char* name;
+        ReaderKind kind;
+    };
+    const Scenario scenarios[] = {
+        { "no readers", ReaderKind::None },
+        { "locked scans (saveToFile)", ReaderKind::Locked },
+        { "admin views (RCU)", ReaderKind::View },
+    };
+
+    vector<pair<const char*, Result>> results;
+    for (const Scenario& scenario : scenarios)
+    {
+        results.push_back({ scenario.name, runScenario(um, firstUserId, users, ms, scenario.kind) });
+    }
+    cout.rdbuf(original);
+
+    printf("users: %d, tasks/user: %d, %d ms per scenario\n", users, tasks, ms);
+    printf("%-28s %10s %10s %10s %10s %12s %8s\n", "scenario", "p50 us", "p99 us", "p99.9 us", "max us", "writer ops", "scans");
+    for (auto& entry : results)
+    {
+        vector<double>& lat = entry.second.latencyUs;
+        sort(lat.begin(), lat.end());
+        printf("%-28s %10.1f %10.1f %10.1f %10.1f %12zu %8lld\n", entry.first,
+               percentile(lat, 50), percentile(lat, 99), percentile(lat, 99.9),
+               lat.empty() ? 0.0 : lat.back(), lat.size(), entry.second.scans);
+    }
+    return 0;
+}
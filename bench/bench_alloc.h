@@ -0,0 +1,61 @@
+#ifndef BENCH_ALLOC_H
+#define BENCH_ALLOC_H
+
+#include <cstdlib>
+#include <new>
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+// Heap accounting for the benchmark programs: replaces the global operator
+// new / delete with counting versions. Defines the replacements, so include
+// it from the benchmark's own .cpp only (one per program).
+
+// GCC cannot see that the replaced new and delete below are a malloc/free pair.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+namespace
+{
+size_t allocCount = 0;
+size_t allocBytes = 0;
+}
+
+void* operator new(size_t size)
+{
+    allocCount++;
+    allocBytes += size;
+    if (void* p = malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+// Memory resources allocate through the aligned form
+void* operator new(size_t size, std::align_val_t alignment)
+{
+    allocCount++;
+    allocBytes += size;
+    size_t align = static_cast<size_t>(alignment);
+    if (void* p = aligned_alloc(align, (size + align - 1) / align * align)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p, std::align_val_t) noexcept { free(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept { free(p); }
+
+// Peak resident set size of the process in MB, 0 where getrusage is not available
+inline double peakRssMb()
+{
+#ifndef _WIN32
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss / 1024.0;   // Kilobytes on Linux
+#else
+    return 0;
+#endif
+}
+
+#endif
@@ -0,0 +1,110 @@
+// Task cleanup: one completeTask / removeTask call per matching task against a
+// single completeTasks / removeTasks call, for one large user and for every user
+//
+// Build: g++ -std=c++17 -O2 -DNDEBUG -pthread -o bench_bulk_tasks bench/bench_bulk_tasks.cpp usermanager.cpp snapshot.cpp parallelload.cpp journal.cpp dateutil.cpp taskcolumns.cpp trigramindex.cpp adminview.cpp identityindex.cpp tablerenderer.cpp opmetrics.cpp bulkimport.cpp bulktasks.cpp terminal.cpp taskowners.cpp reminders.cpp blockcodec.cpp
+// Run:   ./bench_bulk_tasks --tasks 5000 --users 10000 --per-user 20
+#include <cstdio>
+#include <vector>
+#include "../dateutil.h"
+#include "bench_common.h"
+
+namespace
+{
+const char CUTOFF[] = "01/01/2027";
+
+struct Timing
+{
+    double ms;
+    size_t tasks;
+};
+
+// Complete every ongoing task due before CUTOFF, then delete every completed task
+void perTask(UserManager& um, int userId, Timing& complete, Timing& remove)
+{
+    BenchTimer timer;
+    uint32_t before = packDate(CUTOFF);
+    size_t count = 0;
+    for (const DueEntry& entry : um.findTasksDue(1, before - 1, true, userId))
+    {
+        count += um.completeTask(entry.userId, entry.taskId) == OpStatus::Ok;
+    }
+    complete = { timer.millis(), count };
+
+    timer.reset();
+    count = 0;
+    vector<DueEntry> done;
+    for (const DueEntry& entry : um.findTasksDue(0, UINT32_MAX, false, userId))
+    {
+        if (entry.completed) done.push_back(entry);
+    }
+    for (const DueEntry& entry : done)
+    {
+        count += um.removeTask(entry.userId, entry.taskId) == OpStatus::Ok;
+    }
+    remove = { timer.millis(), count };
+}
+
+void bulk(UserManager& um, int userId, Timing& complete, Timing& remove)
+{
+    BenchTimer timer;
+    TaskFilter due;
+    due.dueFrom = 1;
+    due.dueTo = packDate(CUTOFF) - 1;
+    size_t count = 0;
+    um.completeTasks(userId, due, &count);
+    complete = { timer.millis(), count };
+
+    timer.reset();
+    TaskFilter completed;
+    completed.status = TaskFilter::Status::Completed;
+    um.removeTasks(userId, completed, &count);
+    remove = { timer.millis(), count };
+}
+
+void report(const char* scope, const Timing& c1, const Timing& r1, const Timing& c2, const Timing& r2)
+{
+    printf("%-22s %-16s %10.2f %10zu\n", scope, "completeTask x N", c1.ms, c1.tasks);
+    printf("%-22s %-16s %10.2f %10zu\n", scope, "completeTasks", c2.ms, c2.tasks);
+    printf("%-22s %-16s %10.2f %10zu\n", scope, "removeTask x N", r1.ms, r1.tasks);
+    printf("%-22s %-16s %10.2f %10zu\n", scope, "removeTasks", r2.ms, r2.tasks);
+}
+}
+
+int main(int argc, char* argv[])
+{
+    int tasks = static_cast<int>(benchArg(argc, argv, "tasks", 5000));
+    int users = static_cast<int>(benchArg(argc, argv, "users", 10000));
+    int perUser = static_cast<int>(benchArg(argc, argv, "per-user", 20));
+
+    printf("%-22s %-16s %10s %10s\n", "scope", "path", "ms", "tasks");
+
+    // One user with many tasks; the same seed gives both runs the same tasks
+    Timing c1, r1, c2, r2;
+    int userId = 0;
+    {
+        UserManager um;
+        populateUsers(um, 1, tasks);
+        um.loginUser("bench0", "pass0", &userId);
+        perTask(um, userId, c1, r1);
+    }
+    {
+        UserManager um;
+        populateUsers(um, 1, tasks);
+        bulk(um, userId, c2, r2);
+    }
+    report(("1 user x " + to_string(tasks)).c_str(), c1, r1, c2, r2);
+
+    // Every user (admin cleanup)
+    {
+        UserManager um;
+        populateUsers(um, users, perUser);
+        perTask(um, 0, c1, r1);
+    }
+    {
+        UserManager um;
+        populateUsers(um, users, perUser);
+        bulk(um, 0, c2, r2);
+    }
+    report((to_string(users) + " users x " + to_string(perUser)).c_str(), c1, r1, c2, r2);
+    return 0;
+}
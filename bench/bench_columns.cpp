@@ -0,0 +1,93 @@
+// Admin-wide task scans: per-user hash maps (row store) against TaskColumns
+//
+// Build: g++ -std=c++17 -O2 -pthread -o bench_columns bench/bench_columns.cpp usermanager.cpp snapshot.cpp parallelload.cpp journal.cpp dateutil.cpp taskcolumns.cpp trigramindex.cpp adminview.cpp identityindex.cpp tablerenderer.cpp opmetrics.cpp bulkimport.cpp bulktasks.cpp terminal.cpp taskowners.cpp reminders.cpp blockcodec.cpp
+// Run:   ./bench_columns --users 20000 --tasks 50        (1M tasks)
+//        ./bench_columns --users 200000 --tasks 50       (10M tasks, needs several GB of RAM)
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+#include "../dateutil.h"
+#include "../taskcolumns.h"
+#include "bench_common.h"
+
+namespace
+{
+struct ScanTotals
+{
+    size_t completed = 0;
+    size_t overdue = 0;
+    size_t dueSoon = 0;
+
+    bool operator==(const ScanTotals& o) const
+    {
+        return completed == o.completed && overdue == o.overdue && dueSoon == o.dueSoon;
+    }
+};
+
+// What an admin report costs without the columns: walk every user's task map
+// and compare the status string of every task
+ScanTotals scanRows(const UserManager& um, uint32_t today, uint32_t weekAhead)
+{
+    ScanTotals totals;
+    um.forEachUser([&](const User& user)
+    {
+        for (const auto& taskPair : user.tasks)
+        {
+            const Task& task = taskPair.second;
+            uint32_t due = task.dueDate;
+            bool completed = task.status == "Completed";
+            totals.completed += completed;
+            totals.overdue += !completed && due != 0 && due < today;
+            totals.dueSoon += !completed && due >= today && due <= weekAhead;
+        }
+    });
+    return totals;
+}
+
+ScanTotals scanColumns(const TaskColumns& columns, uint32_t today, uint32_t weekAhead)
+{
+    ScanTotals totals;
+    totals.completed = columns.countCompleted();
+    totals.overdue = columns.countOverdue(today);
+    totals.dueSoon = columns.countDueBetween(today, weekAhead);
+    return totals;
+}
+}
+
+int main(int argc, char* argv[])
+{
+    int users = static_cast<int>(benchArg(argc, argv, "users", 20000));
+    int tasks = static_cast<int>(benchArg(argc, argv, "tasks", 50));
+    int rounds = static_cast<int>(benchArg(argc, argv, "rounds", 5));
+
+    ostringstream sink;
+    streambuf* original = cout.rdbuf(sink.rdbuf());
+    UserManager um;
+    long long created = populateUsers(um, users, tasks);
+    cout.rdbuf(original);
+
+    uint32_t today = todayPacked();
+    uint32_t weekAhead = packedDateAfterDays(7);
+
+    BenchTimer timer;
+    TaskColumns columns;
+    columns.build(um);
+    double buildMs = timer.millis();
+
+    ScanTotals rowTotals, columnTotals;
+    timer.reset();
+    for (int r = 0; r < rounds; r++) rowTotals = scanRows(um, today, weekAhead);
+    double rowMs = timer.millis() / rounds;
+
+    timer.reset();
+    for (int r = 0; r < rounds; r++) columnTotals = scanColumns(columns, today, weekAhead);
+    double columnMs = timer.millis() / rounds;
+
+    printf("tasks: %lld across %d users, %d rounds\n", created, users, rounds);
+    printf("%-22s %10s %12s\n", "scan", "ms", "Mtasks/s");
+    printf("%-22s %10.2f %12.1f\n", "row store", rowMs, created / (rowMs * 1000));
+    printf("%-22s %10.2f %12.1f\n", "columns", columnMs, created / (columnMs * 1000));
+    printf("%-22s %10.2f\n", "columns build", buildMs);
+    printf("speedup per scan: %.1fx%s\n", rowMs / columnMs, rowTotals == columnTotals ? "" : "  MISMATCH");
+    return 0;
+}
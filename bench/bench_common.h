@@ -0,0 +1,67 @@
+#ifndef BENCH_COMMON_H
+#define BENCH_COMMON_H
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include "../usermanager.h"
+using namespace std;
+
+// Shared helpers for the benchmark programs in this folder
+
+// Wall clock stopwatch
+class BenchTimer {
+private:
+    chrono::steady_clock::time_point start;
+
+public:
+    BenchTimer() : start(chrono::steady_clock::now()) {}
+    void reset() { start = chrono::steady_clock::now(); }
+    double seconds() const { return chrono::duration<double>(chrono::steady_clock::now() - start).count(); }
+    double millis() const { return seconds() * 1000.0; }
+};
+
+// Integer command line option: --name value, or the default
+inline long long benchArg(int argc, char* argv[], const string& name, long long fallback)
+{
+    for (int i = 1; i + 1 < argc; i++)
+    {
+        if (argv[i] == "--" + name) return atoll(argv[i + 1]);
+    }
+    return fallback;
+}
+
+// Valid DD/MM/YYYY date (passes isValidDate) derived from a random number
+inline string benchDate(unsigned r)
+{
+    char text[11];
+    snprintf(text, sizeof(text), "%02u/%02u/%04u", 1 + r % 28, 1 + (r / 28) % 12, 2024 + (r / 336) % 7);
+    return text;
+}
+
+// Register `users` users with `tasksPerUser` tasks each through the headless API.
+// Every third task is marked completed. Returns the number of tasks created.
+inline long long populateUsers(UserManager& um, int users, int tasksPerUser, unsigned seed = 42)
+{
+    mt19937 rng(seed);
+    long long created = 0;
+    for (int u = 0; u < users; u++)
+    {
+        string name = "bench" + to_string(u);
+        int userId = 0;
+        if (um.registerUser(name, name + "@mail.com", "pass" + to_string(u), &userId) != OpStatus::Ok) continue;
+
+        for (int t = 0; t < tasksPerUser; t++)
+        {
+            int taskId = 0;
+            um.createTask(userId, "Task " + to_string(t) + " for " + name, benchDate(rng()), &taskId);
+            if (t % 3 == 0) um.completeTask(userId, taskId);
+            created++;
+        }
+    }
+    return created;
+}
+
+#endif
@@ -0,0 +1,127 @@
+// Multithreaded stress test of the headless API on a sharded UserManager:
+// throughput of a session-like operation mix at 1, 2, 4, ... threads
+//
+// Build: g++ -std=c++17 -O2 -pthread -o bench_concurrency bench/bench_concurrency.cpp usermanager.cpp snapshot.cpp parallelload.cpp journal.cpp dateutil.cpp taskcolumns.cpp trigramindex.cpp adminview.cpp identityindex.cpp tablerenderer.cpp opmetrics.cpp bulkimport.cpp bulktasks.cpp terminal.cpp taskowners.cpp reminders.cpp blockcodec.cpp
+// Run:   ./bench_concurrency --users 100000 --ops 200000 --shards 64 [--threads max]
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include "bench_common.h"
+
+namespace
+{
+struct OwnedTask
+{
+    int userId;
+    int taskId;
+};
+
+// One session thread: mostly task operations on random users, a few logins and
+// due-date queries, and 1% identity changes that go through the global lock
+void runSession(UserManager& um, int firstUserId, int users, int ops, unsigned seed)
+{
+    mt19937 rng(seed);
+    vector<OwnedTask> owned;
+    owned.reserve(ops / 2);
+
+    for (int i = 0; i < ops; i++)
+    {
+        int userId = firstUserId + static_cast<int>(rng() % users);
+        unsigned pick = rng() % 100;
+
+        if (pick < 30 || owned.empty())
+        {
+            int taskId = 0;
+            if (um.createTask(userId, "Stress task " + to_string(i), benchDate(rng()), &taskId) == OpStatus::Ok)
+            {
+                owned.push_back({ userId, taskId });
+            }
+        }
+        else if (pick < 50)
+        {
+            const OwnedTask& t = owned[rng() % owned.size()];
+            um.completeTask(t.userId, t.taskId);
+        }
+        else if (pick < 65)
+        {
+            const OwnedTask& t = owned[rng() % owned.size()];
+            um.setTaskTitle(t.userId, t.taskId, "Renamed " + to_string(i));
+        }
+        else if (pick < 80)
+        {
+            string name = "bench" + to_string(userId - firstUserId);
+            um.loginUser(name, "pass" + to_string(userId - firstUserId));
+        }
+        else if (pick < 90)
+        {
+            um.findTasksDue(20240101, 20301231, true, userId, 10);
+        }
+        else if (pick < 99)
+        {
+            size_t k = rng() % owned.size();
+            um.removeTask(owned[k].userId, owned[k].taskId);
+            owned[k] = owned.back();
+            owned.pop_back();
+        }
+        else
+        {
+            um.changeEmail(userId, "s" + to_string(seed) + "_" + to_string(i) + "@mail.com");
+        }
+    }
+}
+}
+
+int main(int argc, char* argv[])
+{
+    int users = static_cast<int>(benchArg(argc, argv, "users", 100000));
+    int ops = static_cast<int>(benchArg(argc, argv, "ops", 200000));
+    unsigned shards = static_cast<unsigned>(benchArg(argc, argv, "shards", 64));
+
+    unsigned maxThreads = static_cast<unsigned>(benchArg(argc, argv, "threads", max(1u, thread::hardware_concurrency())));
+    vector<unsigned> threadCounts;
+    for (unsigned threads = 1; threads < maxThreads; threads *= 2) threadCounts.push_back(threads);
+    threadCounts.push_back(maxThreads);
+
+    printf("users: %d, ops per thread: %d, shards: %u\n", users, ops, shards);
+    printf("%-8s %10s %14s %8s %s\n", "threads", "ms", "ops/s", "scaling", "check");
+
+    double baseRate = 0;
+    for (unsigned threads : threadCounts)
+    {
+        ostringstream sink;
+        streambuf* original = cout.rdbuf(sink.rdbuf());
+        UserManager um(shards);
+        populateUsers(um, users, 0);
+        cout.rdbuf(original);
+        int firstUserId = 106; // populateUsers registers after the 5 sample users (101-105)
+
+        BenchTimer timer;
+        vector<thread> pool;
+        for (unsigned t = 0; t < threads; t++)
+        {
+            pool.emplace_back(runSession, ref(um), firstUserId, users, ops, 1000 + t);
+        }
+        for (auto& th : pool)
+        {
+            th.join();
+        }
+        double ms = timer.millis();
+
+        // Counters maintained concurrently must match a full recount
+        long long tasks = 0, completed = 0;
+        um.forEachUser([&](const User& user)
+        {
+            tasks += user.tasks.size();
+            completed += user.completedCount;
+        });
+        bool consistent = tasks == um.getTotalTasksCount() && completed == um.getCompletedTasksCount();
+
+        double rate = static_cast<double>(ops) * threads / (ms / 1000);
+        if (baseRate == 0) baseRate = rate;
+        printf("%-8u %10.1f %14.0f %8.2f %s\n", threads, ms, rate, rate / baseRate, consistent ? "ok" : "MISMATCH");
+    }
+    return 0;
+}
@@ -0,0 +1,132 @@
+#ifndef BENCH_DATASET_H
+#define BENCH_DATASET_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+using namespace std;
+
+// Synthetic data sets in the data.txt format, shared by gen_dataset and the
+// benchmarks that need a realistic file to load.
+
+struct DatasetOptions {
+    int users = 100000;
+    double meanTasks = 20;      // Average tasks per user
+    double skew = 1.5;          // Pareto shape of tasks per user: lower = heavier tail, 0 = every user gets meanTasks
+    int maxTasks = 10000;       // Cap for the heaviest users
+    double completedShare = 0.35;
+    double inactiveShare = 0.05;
+    unsigned seed = 42;
+};
+
+struct DatasetStats {
+    long long users = 0;
+    long long tasks = 0;
+    long long completed = 0;
+    int heaviestUser = 0;       // Most tasks of one user
+    long long bytes = 0;
+};
+
+namespace dataset
+{
+const char* const FIRST_NAMES[] = {
+    "alex", "maria", "tanvir", "sadik", "himel", "anam", "tayeen", "olivia", "liam", "emma",
+    "noah", "ava", "lucas", "mia", "arjun", "fatima", "chen", "yuki", "sofia", "omar",
+    "nadia", "ivan", "lena", "diego", "priya", "kofi", "amira", "jonas", "elena", "rahim"
+};
+const char* const DOMAINS[] = { "gmail.com", "yahoo.com", "outlook.com", "mail.com", "proton.me", "company.org" };
+const char* const VERBS[] = {
+    "Review", "Prepare", "Update", "Call", "Email", "Fix", "Plan", "Book", "Submit", "Draft",
+    "Organize", "Pay", "Renew", "Schedule", "Clean", "Buy", "Finish", "Test", "Backup", "Read"
+};
+const char* const OBJECTS[] = {
+    "quarterly report", "budget", "client", "invoice", "meeting notes", "flight", "presentation",
+    "insurance", "doctor appointment", "groceries", "project proposal", "tax return", "website",
+    "garage", "birthday gift", "code review", "onboarding docs", "server", "rent", "thesis chapter"
+};
+const char* const QUALIFIERS[] = {
+    "", "", "", " for Monday", " before the deadline", " with the team", " again", " (urgent)",
+    " for next week", " and follow up"
+};
+
+template <typename T, size_t N>
+const T& pick(const T (&items)[N], mt19937& rng) { return items[rng() % N]; }
+
+inline bool isLeap(int year) { return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0; }
+
+// Real calendar date in 2024-2030 (the range isValidDate accepts) as DD/MM/YYYY
+inline string randomDate(mt19937& rng)
+{
+    static const int DAYS[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    int year = 2024 + static_cast<int>(rng() % 7);
+    int month = 1 + static_cast<int>(rng() % 12);
+    int days = DAYS[month - 1] + (month == 2 && isLeap(year) ? 1 : 0);
+    int day = 1 + static_cast<int>(rng() % days);
+    char text[24];
+    snprintf(text, sizeof(text), "%02d/%02d/%04d", day, month, year);
+    return text;
+}
+
+// "<verb> <object><qualifier>" - 8 to 50 characters
+inline string randomTitle(mt19937& rng)
+{
+    return string(pick(VERBS, rng)) + " " + pick(OBJECTS, rng) + pick(QUALIFIERS, rng);
+}
+
+// Tasks of one user: Pareto distributed with the requested mean, so most users
+// hold a few tasks and a few users hold thousands
+inline int taskCount(const DatasetOptions& options, mt19937& rng)
+{
+    if (options.skew <= 1.0) return static_cast<int>(options.meanTasks);
+
+    double scale = options.meanTasks * (options.skew - 1.0) / options.skew;
+    double u = uniform_real_distribution<double>(0.0, 1.0)(rng);
+    double tasks = scale / pow(1.0 - u, 1.0 / options.skew);
+    return static_cast<int>(min<double>(tasks, options.maxTasks));
+}
+
+inline string username(long long index, mt19937& rng) { return pick(FIRST_NAMES, rng) + to_string(index); }
+}
+
+// Write a data set in the saveToFile text format (titles with '_' for spaces).
+// User IDs start at 101 and task IDs at 1001 like a fresh UserManager.
+inline DatasetStats writeTextDataset(const string& path, const DatasetOptions& options)
+{
+    DatasetStats stats;
+    FILE* file = fopen(path.c_str(), "w");
+    if (!file) return stats;
+
+    mt19937 rng(options.seed);
+    fprintf(file, "\n\t\t*** Users Data ***\n\n     User Id     User Name       Email           Password      Status\n");
+    int taskId = 1001;
+    for (int u = 0; u < options.users; u++)
+    {
+        int id = 101 + u;
+        string name = dataset::username(id, rng);
+        bool active = uniform_real_distribution<double>(0.0, 1.0)(rng) >= options.inactiveShare;
+        fprintf(file, "\nUser --> %d        %s        %s@%s        pw%08x        %s\n", id, name.c_str(),
+                name.c_str(), dataset::pick(dataset::DOMAINS, rng), static_cast<unsigned>(rng()),
+                active ? "Active" : "Inactive");
+
+        int count = dataset::taskCount(options, rng);
+        for (int t = 0; t < count; t++)
+        {
+            string title = dataset::randomTitle(rng);
+            replace(title.begin(), title.end(), ' ', '_');
+            bool completed = uniform_real_distribution<double>(0.0, 1.0)(rng) < options.completedShare;
+            fprintf(file, "TASK %d %s %s %s\n", taskId++, title.c_str(), dataset::randomDate(rng).c_str(),
+                    completed ? "Completed" : "Ongoing");
+            stats.completed += completed;
+        }
+        stats.users++;
+        stats.tasks += count;
+        stats.heaviestUser = max(stats.heaviestUser, count);
+    }
+    stats.bytes = ftell(file);
+    fclose(file);
+    return stats;
+}
+
+#endif
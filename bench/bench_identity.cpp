@@ -0,0 +1,136 @@
+// Memory and lookup cost of the username / email indexes: the old layout
+// (username and email maps plus the two uniqueness sets, all owning string
+// copies) against the flat IdentityIndex that views the User strings
+//
+// Build: g++ -std=c++17 -O2 -pthread -o bench_identity bench/bench_identity.cpp usermanager.cpp snapshot.cpp parallelload.cpp journal.cpp dateutil.cpp taskcolumns.cpp trigramindex.cpp adminview.cpp identityindex.cpp tablerenderer.cpp opmetrics.cpp bulkimport.cpp bulktasks.cpp terminal.cpp taskowners.cpp reminders.cpp blockcodec.cpp
+// Run:   ./bench_identity --users 1000000
+#include <cstdio>
+#include <cstdlib>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "bench_alloc.h"
+#include "bench_common.h"
+
+namespace
+{
+// The four containers UserManager kept before the identity index
+struct OldIdentity
+{
+    unordered_map<string, int> usersByUsername;
+    unordered_map<string, int> usersByEmail;
+    unordered_set<string> usedUsernames;
+    unordered_set<string> usedEmails;
+};
+
+struct Cost
+{
+    double buildMs;
+    size_t allocations;
+    size_t bytes;
+    double hitNs;
+    double missNs;
+};
+
+// ns per lookup over every probe, summing the IDs so the loop is not removed
+template <typename Find>
+double lookupNs(const vector<string>& probes, Find find, long long& sink)
+{
+    BenchTimer timer;
+    for (const string& probe : probes)
+    {
+        sink += find(probe);
+    }
+    return timer.seconds() * 1e9 / probes.size();
+}
+
+void printRow(const char* label, const Cost& c, int users)
+{
+    printf("%-24s %10.1f %12zu %14.1f %10.1f %10.1f\n", label, c.buildMs, c.allocations,
+           static_cast<double>(c.bytes) / users, c.hitNs, c.missNs);
+}
+}
+
+int main(int argc, char* argv[])
+{
+    int users = static_cast<int>(benchArg(argc, argv, "users", 1000000));
+
+    // The records the index views - reserved up front so the strings never move
+    vector<User> records;
+    records.reserve(users);
+    for (int u = 0; u < users; u++)
+    {
+        string name = "bench" + to_string(u);
+        records.emplace_back(101 + u, name, name + "@mail.com", "pass" + to_string(u));
+    }
+
+    // Half the probes hit (shuffled), half miss
+    mt19937 rng(7);
+    vector<string> hits, misses;
+    for (int i = 0; i < users; i++)
+    {
+        const User& user = records[rng() % users];
+        hits.push_back(i % 2 ? user.username : user.email);
+        misses.push_back(i % 2 ? "nobody" + to_string(i) : "nobody" + to_string(i) + "@mail.com");
+    }
+    long long sink = 0;
+
+    Cost oldCost, newCost;
+    {
+        size_t count = allocCount, bytes = allocBytes;
+        BenchTimer timer;
+        OldIdentity old;
+        old.usersByUsername.reserve(users);
+        old.usersByEmail.reserve(users);
+        old.usedUsernames.reserve(users);
+        old.usedEmails.reserve(users);
+        for (const User& user : records)
+        {
+            old.usersByUsername[user.username] = user.id;
+            old.usersByEmail[user.email] = user.id;
+            old.usedUsernames.insert(user.username);
+            old.usedEmails.insert(user.email);
+        }
+        oldCost.buildMs = timer.millis();
+        oldCost.allocations = allocCount - count;
+        oldCost.bytes = allocBytes - bytes;
+
+        auto find = [&](const string& key)
+        {
+            const unordered_map<string, int>& map = key.find('@') == string::npos ? old.usersByUsername : old.usersByEmail;
+            auto it = map.find(key);
+            return it == map.end() ? 0 : it->second;
+        };
+        oldCost.hitNs = lookupNs(hits, find, sink);
+        oldCost.missNs = lookupNs(misses, find, sink);
+    }
+    {
+        size_t count = allocCount, bytes = allocBytes;
+        BenchTimer timer;
+        IdentityIndex index;
+        index.reserve(users);
+        for (const User& user : records)
+        {
+            index.add(user.id, user.username, user.email);
+        }
+        newCost.buildMs = timer.millis();
+        newCost.allocations = allocCount - count;
+        newCost.bytes = allocBytes - bytes;
+
+        auto find = [&](const string& key)
+        {
+            return key.find('@') == string::npos ? index.findUsername(key) : index.findEmail(key);
+        };
+        newCost.hitNs = lookupNs(hits, find, sink);
+        newCost.missNs = lookupNs(misses, find, sink);
+    }
+
+    printf("users: %d (checksum %lld)\n", users, sink);
+    printf("%-24s %10s %12s %14s %10s %10s\n", "index", "build ms", "allocations", "bytes per user", "hit ns", "miss ns");
+    printRow("maps + sets (old)", oldCost, users);
+    printRow("IdentityIndex", newCost, users);
+    printf("saved per user: %.1f bytes (%.0f%%)\n",
+           (static_cast<double>(oldCost.bytes) - newCost.bytes) / users,
+           100.0 * (1.0 - static_cast<double>(newCost.bytes) / oldCost.bytes));
+    return 0;
+}
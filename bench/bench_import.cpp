@@ -0,0 +1,71 @@
+// Onboarding a batch of users: one registerUser call per row against a single
+// importUsers call (parallel validation, one reserve, one lock for the batch)
+//
+// Build: g++ -std=c++17 -O2 -pthread -o bench_import bench/bench_import.cpp usermanager.cpp snapshot.cpp parallelload.cpp journal.cpp dateutil.cpp taskcolumns.cpp trigramindex.cpp adminview.cpp identityindex.cpp tablerenderer.cpp opmetrics.cpp bulkimport.cpp bulktasks.cpp terminal.cpp taskowners.cpp reminders.cpp blockcodec.cpp
+// Run:   ./bench_import --existing 100000 --batch 100000
+#include <cstdio>
+#include <vector>
+#include "bench_alloc.h"
+#include "bench_common.h"
+
+namespace
+{
+// Rows for one department; every 50th row is invalid or a duplicate
+vector<ImportUser> makeBatch(int count)
+{
+    vector<ImportUser> rows;
+    rows.reserve(count);
+    for (int i = 0; i < count; i++)
+    {
+        string name = "staff" + to_string(i);
+        ImportUser row = { name, name + "@company.org", "pass" + to_string(i) };
+        if (i % 100 == 49) row.email = "no-at-sign";
+        if (i % 100 == 99) row.username = "staff" + to_string(i - 1);
+        rows.push_back(row);
+    }
+    return rows;
+}
+
+struct Result
+{
+    double ms;
+    size_t accepted;
+    size_t allocations;
+};
+}
+
+int main(int argc, char* argv[])
+{
+    int existing = static_cast<int>(benchArg(argc, argv, "existing", 100000));
+    int batchSize = static_cast<int>(benchArg(argc, argv, "batch", 100000));
+    vector<ImportUser> rows = makeBatch(batchSize);
+
+    Result perRow, bulk;
+    {
+        UserManager um;
+        populateUsers(um, existing, 0);
+        size_t count = allocCount;
+        BenchTimer timer;
+        size_t accepted = 0;
+        for (const ImportUser& row : rows)
+        {
+            accepted += um.registerUser(row.username, row.email, row.password) == OpStatus::Ok;
+        }
+        perRow = { timer.millis(), accepted, allocCount - count };
+    }
+    {
+        UserManager um;
+        populateUsers(um, existing, 0);
+        size_t count = allocCount;
+        BenchTimer timer;
+        ImportReport report = um.importUsers(rows);
+        bulk = { timer.millis(), report.userIds.size(), allocCount - count };
+    }
+
+    printf("existing users: %d, batch rows: %d\n", existing, batchSize);
+    printf("%-22s %10s %10s %12s\n", "path", "ms", "accepted", "allocations");
+    printf("%-22s %10.1f %10zu %12zu\n", "registerUser per row", perRow.ms, perRow.accepted, perRow.allocations);
+    printf("%-22s %10.1f %10zu %12zu\n", "importUsers", bulk.ms, bulk.accepted, bulk.allocations);
+    printf("speedup: %.1fx\n", perRow.ms / bulk.ms);
+    return 0;
+}
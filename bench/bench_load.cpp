@@ -0,0 +1,72 @@
+// Text loader benchmark: loadFromFile against loadFromFileParallel
+//
+// Build: g++ -std=c++17 -O2 -pthread -o bench_load bench/bench_load.cpp usermanager.cpp snapshot.cpp parallelload.cpp journal.cpp dateutil.cpp taskcolumns.cpp trigramindex.cpp adminview.cpp identityindex.cpp tablerenderer.cpp opmetrics.cpp bulkimport.cpp bulktasks.cpp terminal.cpp taskowners.cpp reminders.cpp blockcodec.cpp
+// Run:   ./bench_load --users 100000 --tasks 20
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include "bench_common.h"
+
+int main(int argc, char* argv[])
+{
+    int users = static_cast<int>(benchArg(argc, argv, "users", 100000));
+    int tasks = static_cast<int>(benchArg(argc, argv, "tasks", 20));
+    string path = "bench_load_data.txt";
+
+    // Silence the loaders' status lines while timing
+    ostringstream sink;
+    streambuf* original = cout.rdbuf(sink.rdbuf());
+
+    {
+        UserManager source;
+        populateUsers(source, users, tasks);
+        source.saveToFile(path);
+    }
+
+    auto measure = [&](unsigned threads, int& loadedUsers, int& loadedTasks) {
+        UserManager um;
+        BenchTimer timer;
+        if (threads == 0) um.loadFromFile(path);
+        else um.loadFromFileParallel(path, threads);
+        double ms = timer.millis();
+        loadedUsers = um.getTotalUsersCount();
+        loadedTasks = um.getTotalTasksCount();
+        return ms;
+    };
+
+    int baseUsers = 0, baseTasks = 0;
+    double baseMs = measure(0, baseUsers, baseTasks);
+
+    cout.rdbuf(original);
+    FILE* f = fopen(path.c_str(), "rb");
+    fseek(f, 0, SEEK_END);
+    double megabytes = ftell(f) / 1e6;
+    fclose(f);
+
+    printf("file: %s (%.1f MB, %d users, %d tasks)\n", path.c_str(), megabytes, baseUsers, baseTasks);
+    printf("%-22s %10s %10s %8s\n", "loader", "ms", "MB/s", "speedup");
+    printf("%-22s %10.1f %10.1f %8.2f\n", "loadFromFile", baseMs, megabytes / (baseMs / 1000), 1.0);
+
+    // 1, 2, 4, ... up to and including the core count
+    unsigned maxThreads = max(1u, thread::hardware_concurrency());
+    vector<unsigned> threadCounts;
+    for (unsigned threads = 1; threads < maxThreads; threads *= 2) threadCounts.push_back(threads);
+    threadCounts.push_back(maxThreads);
+
+    for (unsigned threads : threadCounts)
+    {
+        int loadedUsers = 0, loadedTasks = 0;
+        cout.rdbuf(sink.rdbuf());
+        double ms = measure(threads, loadedUsers, loadedTasks);
+        cout.rdbuf(original);
+
+        string label = "parallel x" + to_string(threads);
+        printf("%-22s %10.1f %10.1f %8.2f%s\n", label.c_str(), ms, megabytes / (ms / 1000), baseMs / ms,
+               (loadedUsers == baseUsers && loadedTasks == baseTasks) ? "" : "  MISMATCH");
+    }
+
+    remove(path.c_str());
+    return 0;
+}
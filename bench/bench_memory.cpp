@@ -0,0 +1,100 @@
+// Heap allocations and peak RSS of loading a synthetic data.txt and of
+// task delete / re-create churn. Build it twice to compare the shard pools
+// with plain new/delete:
+//
+// Build: g++ -std=c++17 -O2 -pthread -o bench_memory bench/bench_memory.cpp usermanager.cpp snapshot.cpp parallelload.cpp journal.cpp dateutil.cpp taskcolumns.cpp trigramindex.cpp adminview.cpp identityindex.cpp tablerenderer.cpp opmetrics.cpp bulkimport.cpp bulktasks.cpp terminal.cpp taskowners.cpp reminders.cpp blockcodec.cpp
+//        add -DTASK_PLANNER_NO_POOLS for the new/delete baseline
+// Run:   ./bench_memory --users 100000 --tasks 20 --churn 3
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <utility>
+#include <vector>
+#include "bench_alloc.h"
+#include "bench_common.h"
+#include "bench_dataset.h"
+
+namespace
+{
+struct Measurement
+{
+    double ms;
+    size_t allocations;
+    size_t bytes;
+};
+
+template <typename Fn>
+Measurement measure(Fn fn)
+{
+    size_t count = allocCount, bytes = allocBytes;
+    BenchTimer timer;
+    fn();
+    return { timer.millis(), allocCount - count, allocBytes - bytes };
+}
+
+void printRow(const char* label, const Measurement& m)
+{
+    printf("%-26s %10.1f %12zu %12.1f\n", label, m.ms, m.allocations, m.bytes / 1e6);
+}
+}
+
+int main(int argc, char* argv[])
+{
+    int users = static_cast<int>(benchArg(argc, argv, "users", 100000));
+    int tasks = static_cast<int>(benchArg(argc, argv, "tasks", 20));
+    int churn = static_cast<int>(benchArg(argc, argv, "churn", 3));
+    string path = "bench_memory_data.txt";
+    // Written directly so generating it does not raise the peak RSS being measured.
+    // Same task count for every user (no skew) so both builds load the same shape.
+    DatasetOptions options;
+    options.users = users;
+    options.meanTasks = tasks;
+    options.skew = 0;
+    writeTextDataset(path, options);
+
+    ostringstream discard;
+    streambuf* original = cout.rdbuf(discard.rdbuf());
+
+    UserManager um;
+    Measurement load = measure([&] { um.loadFromFile(path); });
+    double loadPeak = peakRssMb();
+
+    // Each round deletes every other task of every user and creates as many new ones
+    mt19937 rng(7);
+    Measurement churned = measure([&]
+    {
+        vector<pair<int, int>> victims;
+        for (int round = 0; round < churn; round++)
+        {
+            victims.clear();
+            um.forEachUser([&](const User& user)
+            {
+                bool pick = round % 2 == 0;
+                for (const auto& taskPair : user.tasks)
+                {
+                    if (pick) victims.emplace_back(user.id, taskPair.first);
+                    pick = !pick;
+                }
+            });
+            for (const auto& victim : victims)
+            {
+                um.removeTask(victim.first, victim.second);
+                um.createTask(victim.first, "Follow up on the weekly report", benchDate(rng()));
+            }
+        }
+    });
+    cout.rdbuf(original);
+    remove(path.c_str());
+
+#ifdef TASK_PLANNER_NO_POOLS
+    const char* mode = "new/delete";
+#else
+    const char* mode = "shard pools";
+#endif
+    printf("users: %d, tasks: %d, allocator: %s\n", users, um.getTotalTasksCount(), mode);
+    printf("%-26s %10s %12s %12s\n", "phase", "ms", "allocations", "MB allocated");
+    printRow("loadFromFile", load);
+    printRow("delete/create churn", churned);
+    printf("peak RSS after load: %.1f MB, after churn: %.1f MB\n", loadPeak, peakRssMb());
+    return 0;
+}
@@ -0,0 +1,92 @@
+// Reminder scheduler on a simulated clock: a million tasks scheduled through
+// UserManager, edited, completed and deleted, then the clock advanced a day at
+// a time. Checks every surviving task fires DueSoon then Overdue exactly once,
+// and prints a checksum that is the same on every run.
+//
+// Build: g++ -std=c++17 -O2 -DNDEBUG -pthread -o bench_reminders bench/bench_reminders.cpp usermanager.cpp snapshot.cpp parallelload.cpp journal.cpp dateutil.cpp taskcolumns.cpp trigramindex.cpp adminview.cpp identityindex.cpp tablerenderer.cpp opmetrics.cpp bulkimport.cpp bulktasks.cpp terminal.cpp taskowners.cpp reminders.cpp blockcodec.cpp
+// Run:   ./bench_reminders --users 100000 --tasks 10 --churn 200000
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "bench_common.h"
+#include "../dateutil.h"
+#include "../reminders.h"
+
+int main(int argc, char* argv[])
+{
+    int users = static_cast<int>(benchArg(argc, argv, "users", 100000));
+    int tasksPerUser = static_cast<int>(benchArg(argc, argv, "tasks", 10));
+    int churn = static_cast<int>(benchArg(argc, argv, "churn", 200000));
+    const uint32_t START = 20240101;              // Fixed start, so every run is the same
+    const uint32_t END = 20310101;                // Past the last date benchDate makes
+
+    UserManager um(4);
+    ReminderScheduler reminders(START, 1, 4096);
+    um.attachReminders(&reminders);
+
+    // Task ID -> 0 nothing fired, 1 DueSoon fired, 2 Overdue fired
+    vector<uint8_t> state;
+    long long fired = 0, batches = 0, misordered = 0;
+    uint64_t checksum = 0;
+    CallbackReminderSink sink([&](const vector<Reminder>& batch)
+    {
+        batches++;
+        for (const Reminder& r : batch)
+        {
+            uint8_t& s = state[r.taskId - 1001];
+            uint8_t expected = r.kind == Reminder::Kind::DueSoon ? 0 : 1;
+            if (s != expected) misordered++;
+            s = expected + 1;
+            checksum = checksum * 1000003 + static_cast<uint64_t>(r.taskId) * 31 + r.firedOn;
+            fired++;
+        }
+    });
+    reminders.attachSink(&sink);
+
+    BenchTimer timer;
+    long long tasks = populateUsers(um, users, tasksPerUser);
+    double populateS = timer.seconds();
+    state.assign(static_cast<size_t>(tasks), 0);
+    size_t scheduled = reminders.pending();
+
+    // Churn: new due dates, completions and deletions on random tasks
+    mt19937 rng(11);
+    timer.reset();
+    for (int i = 0; i < churn; i++)
+    {
+        int taskId = 1001 + static_cast<int>(rng() % tasks);
+        int owner = 0;
+        if (um.findTask(taskId, &owner) != OpStatus::Ok) continue;
+        switch (rng() % 3)
+        {
+            case 0: um.setTaskDueDate(owner, taskId, benchDate(rng())); break;
+            case 1: um.completeTask(owner, taskId); break;
+            default: um.removeTask(owner, taskId); break;
+        }
+    }
+    double churnS = timer.seconds();
+    size_t live = reminders.pending();
+
+    timer.reset();
+    long long days = 0;
+    for (uint32_t day = START; day < END; day = packedDateOfDay(dayNumber(day) + 1), days++)
+    {
+        reminders.advanceTo(day);
+    }
+    reminders.advanceTo(END);
+    double fireS = timer.seconds();
+
+    long long incomplete = 0;
+    for (uint8_t s : state) incomplete += (s == 1);
+    bool ok = misordered == 0 && incomplete == 0 && fired == static_cast<long long>(live) * 2 && reminders.pending() == 0;
+
+    printf("%d users x %d tasks (%lld tasks), %zu scheduled, %zu live after %d churn ops\n",
+           users, tasksPerUser, tasks, scheduled, live, churn);
+    printf("%-28s %14.0f tasks/s (through createTask)\n", "populate + schedule", tasks / populateS);
+    printf("%-28s %14.0f ops/s\n", "churn", churn / churnS);
+    printf("%-28s %14.0f reminders/s (%lld fired, %lld days, %lld batches)\n", "advance day by day",
+           fired / fireS, fired, days, batches);
+    printf("%s: misordered %lld, DueSoon only %lld, checksum %016llx\n", ok ? "ok" : "FAILED",
+           misordered, incomplete, static_cast<unsigned long long>(checksum));
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,109 @@
+// Console listings written to the null device: the old per-field cout / setw /
+// endl loops against the table pages the screens write now (one page holding
+// every row, where the screens stop after each page)
+//
+// Build: g++ -std=c++17 -O2 -pthread -o bench_render bench/bench_render.cpp usermanager.cpp snapshot.cpp parallelload.cpp journal.cpp dateutil.cpp taskcolumns.cpp trigramindex.cpp adminview.cpp identityindex.cpp tablerenderer.cpp opmetrics.cpp bulkimport.cpp bulktasks.cpp terminal.cpp taskowners.cpp reminders.cpp blockcodec.cpp
+// Run:   ./bench_render --users 100000 --tasks 10
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include "bench_common.h"
+#include "../dateutil.h"
+
+namespace
+{
+#ifdef _WIN32
+const char NULL_FILE[] = "NUL";
+#else
+const char NULL_FILE[] = "/dev/null";
+#endif
+
+// The user listing as it was: setw per field and a flush per row
+void oldUserListing(const AdminView& view, ostream& out)
+{
+    out << setw(5) << "ID" << setw(15) << "Username" << setw(25) << "Email" << setw(10) << "Status" << endl;
+    out << string(55, '-') << endl;
+    for (const auto& summary : view.users)
+    {
+        const UserSummary& user = *summary;
+        string status = user.isActive ? "Active" : "Inactive";
+        out << setw(5) << user.id
+            << setw(15) << user.username
+            << setw(25) << user.email
+            << setw(10) << status << endl;
+    }
+}
+
+// The task listing as it was: a string copy and substr per long title
+void oldTaskListing(const User& user, ostream& out)
+{
+    out << left << setw(8) << "ID" << setw(25) << "Title" << setw(12) << "Due Date" << setw(12) << "Status" << "\n";
+    out << string(57, '-') << "\n";
+    for (const auto& pair : user.tasks)
+    {
+        const Task& task = pair.second;
+        out << left << setw(8) << task.taskId;
+        string displayTitle(task.title);
+        if (displayTitle.length() > 24)
+        {
+            displayTitle = displayTitle.substr(0, 21) + "...";
+        }
+        out << setw(25) << displayTitle;
+        out << setw(12) << unpackDate(task.dueDate);
+        out << setw(12) << task.status << "\n";
+    }
+    out << right;
+}
+}
+
+int main(int argc, char* argv[])
+{
+    int users = static_cast<int>(benchArg(argc, argv, "users", 100000));
+    int tasks = static_cast<int>(benchArg(argc, argv, "tasks", 10));
+
+    UserManager um;
+    populateUsers(um, users, tasks);
+    shared_ptr<const AdminView> view = um.adminView();
+
+    // The screens print to cout - point it at the null device
+    ofstream nullFile(NULL_FILE);
+    streambuf* original = cout.rdbuf(nullFile.rdbuf());
+
+    BenchTimer timer;
+    oldUserListing(*view, cout);
+    double oldUsersMs = timer.millis();
+
+    timer.reset();
+    UserCursor userCursor;
+    um.writeUserPage(cout, userCursor);
+    cout.flush();
+    double newUsersMs = timer.millis();
+
+    // Every user's own task list, the way the user portal shows it
+    long long rows = 0;
+    timer.reset();
+    um.forEachUserById([&](const User& user)
+    {
+        oldTaskListing(user, cout);
+        rows += static_cast<long long>(user.tasks.size());
+    });
+    cout.flush();
+    double oldTasksMs = timer.millis();
+
+    timer.reset();
+    for (const auto& summary : view->users)
+    {
+        TaskCursor taskCursor;
+        um.writeTaskPage(cout, summary->id, taskCursor);
+    }
+    cout.flush();
+    double newTasksMs = timer.millis();
+    cout.rdbuf(original);
+
+    printf("users: %d, task rows: %lld\n", users, rows);
+    printf("%-22s %14s %14s %10s\n", "listing", "cout/setw ms", "renderer ms", "speedup");
+    printf("%-22s %14.1f %14.1f %9.1fx\n", "all users", oldUsersMs, newUsersMs, oldUsersMs / newUsersMs);
+    printf("%-22s %14.1f %14.1f %9.1fx\n", "every user's tasks", oldTasksMs, newTasksMs, oldTasksMs / newTasksMs);
+    return 0;
+}
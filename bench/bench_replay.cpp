@@ -0,0 +1,321 @@
+// Session replay load driver: runs batch-script sessions against one
+// UserManager and reports throughput and latency percentiles per command.
+//
+// Either replays a recorded script (the batch format of batchexecutor.h) or
+// generates randomized sessions - a login (or a registration) followed by a
+// mix of task edits and admin searches - on several threads. --data preloads
+// a data set (see gen_dataset) as background volume; the sessions act on
+// their own accounts, registered before the clock starts. --record writes the
+// generated commands as a script that replays the same run (single thread).
+//
+// Build: g++ -std=c++17 -O2 -pthread -o bench_replay bench/bench_replay.cpp batchexecutor.cpp usermanager.cpp snapshot.cpp parallelload.cpp journal.cpp dateutil.cpp taskcolumns.cpp trigramindex.cpp adminview.cpp identityindex.cpp tablerenderer.cpp opmetrics.cpp bulkimport.cpp bulktasks.cpp terminal.cpp taskowners.cpp reminders.cpp blockcodec.cpp
+// Run:   ./bench_replay --data data.txt --sessions 100000 --threads 4
+//        ./bench_replay --sessions 10000 --threads 1 --record session.txt
+//        ./bench_replay --script session.txt
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include "bench_common.h"
+#include "bench_dataset.h"
+#include "../batchexecutor.h"
+
+namespace
+{
+string textArg(int argc, char* argv[], const string& name, const string& fallback)
+{
+    for (int i = 1; i + 1 < argc; i++)
+    {
+        if (argv[i] == "--" + name) return argv[i + 1];
+    }
+    return fallback;
+}
+
+// Latencies of one thread, in nanoseconds, by command name
+struct Latencies {
+    map<string, vector<double>> byCommand;
+    long long failed = 0;
+    long long parseErrors = 0;
+};
+
+// Parse, then time only the execution of one script line
+CommandResponse runLine(BatchExecutor& executor, const string& line, Latencies& latencies, ostream* record)
+{
+    CommandRequest request;
+    string error;
+    if (!BatchExecutor::parseCommand(line, request, error))
+    {
+        if (!error.empty()) latencies.parseErrors++;
+        return { OpStatus::NoChange };   // Nothing ran
+    }
+    if (record) *record << line << '\n';
+
+    BenchTimer timer;
+    CommandResponse response = executor.execute(request);
+    double ns = timer.seconds() * 1e9;
+    latencies.byCommand[line.substr(0, line.find(' '))].push_back(ns);
+    if (!response.ok()) latencies.failed++;
+    return response;
+}
+
+// Account driven by the generated sessions, with the tasks it owns
+struct Account {
+    string username;
+    string password;
+    int userId = 0;
+    vector<int> tasks;
+};
+
+// Randomized sessions on one thread, over accounts only this thread uses
+class SessionGenerator {
+private:
+    BatchExecutor& executor;
+    Latencies& latencies;
+    ostream* record;
+    mt19937 rng;
+    vector<Account> accounts;
+    string prefix;
+
+    // Run a line and return its response (for the IDs it creates)
+    CommandResponse execute(const string& line) { return runLine(executor, line, latencies, record); }
+
+    string quoted(const string& text) { return "\"" + text + "\""; }
+
+    int pickTask(Account& account) { return account.tasks[rng() % account.tasks.size()]; }
+
+    void dropTask(Account& account, int taskId)
+    {
+        auto found = find(account.tasks.begin(), account.tasks.end(), taskId);
+        if (found == account.tasks.end()) return;
+        *found = account.tasks.back();
+        account.tasks.pop_back();
+    }
+
+    void addTask(Account& account)
+    {
+        CommandResponse response = execute("add-task " + to_string(account.userId) + " " +
+                                           quoted(dataset::randomTitle(rng)) + " " + dataset::randomDate(rng));
+        if (response.ok()) account.tasks.push_back(response.taskId);
+    }
+
+    // One user action; the mix is weighted towards adding and completing tasks
+    void action(Account& account)
+    {
+        unsigned roll = rng() % 100;
+        if (account.tasks.empty() || roll < 35)
+        {
+            addTask(account);
+            return;
+        }
+
+        int taskId = pickTask(account);
+        string ids = to_string(account.userId) + " " + to_string(taskId);
+        if (roll < 45)
+        {
+            execute("edit-title " + ids + " " + quoted(dataset::randomTitle(rng)));
+        }
+        else if (roll < 55)
+        {
+            execute("edit-due " + ids + " " + dataset::randomDate(rng));
+        }
+        else if (roll < 75)
+        {
+            execute("complete " + ids);
+        }
+        else if (roll < 85)
+        {
+            if (execute("delete-task " + ids).ok()) dropTask(account, taskId);
+        }
+        else
+        {
+            // Admin search: a name prefix, or the tail of a known username
+            const Account& other = accounts[rng() % accounts.size()];
+            string keyword = rng() % 2 ? string(dataset::pick(dataset::FIRST_NAMES, rng))
+                                       : other.username.substr(other.username.size() - min<size_t>(other.username.size(), 5));
+            execute("search " + keyword);
+        }
+    }
+
+    // Next account of this thread and the register line that creates it
+    Account nextAccount(string& line)
+    {
+        Account account;
+        account.username = prefix + to_string(accounts.size());
+        account.password = "pw" + to_string(rng() % 100000);
+        line = "register " + account.username + " " + account.username + "@replay.com " + account.password;
+        return account;
+    }
+
+public:
+    SessionGenerator(BatchExecutor& executor, Latencies& latencies, ostream* record, unsigned seed, int thread)
+        : executor(executor), latencies(latencies), record(record), rng(seed), prefix("replay" + to_string(thread) + "_")
+    {
+    }
+
+    // Accounts that exist before the measured sessions start (not timed)
+    void registerAccounts(int count)
+    {
+        Latencies untimed;
+        string line;
+        for (int i = 0; i < count; i++)
+        {
+            Account account = nextAccount(line);
+            account.userId = runLine(executor, line, untimed, record).userId;
+            if (account.userId) accounts.push_back(account);
+        }
+    }
+
+    // ~10% of sessions register a new account, the rest log in to an existing one,
+    // then 3 to 12 actions follow
+    void session()
+    {
+        size_t index;
+        if (accounts.empty() || rng() % 10 == 0)
+        {
+            string line;
+            Account account = nextAccount(line);
+            CommandResponse response = execute(line);
+            if (!response.ok()) return;
+            account.userId = response.userId;
+            accounts.push_back(account);
+            index = accounts.size() - 1;
+        }
+        else
+        {
+            index = rng() % accounts.size();
+            const Account& account = accounts[index];
+            if (!execute("login " + account.username + " " + account.password).ok()) return;
+        }
+
+        int actions = 3 + static_cast<int>(rng() % 10);
+        for (int i = 0; i < actions; i++)
+        {
+            action(accounts[index]);
+        }
+    }
+};
+
+double percentile(const vector<double>& sorted, double p)
+{
+    if (sorted.empty()) return 0;
+    size_t index = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+    return sorted[min(index, sorted.size() - 1)];
+}
+
+void printRow(const string& name, vector<double>& ns)
+{
+    sort(ns.begin(), ns.end());
+    printf("%-16s %10zu %10.2f %10.2f %10.2f %10.2f %10.2f\n", name.c_str(), ns.size(), percentile(ns, 0.50) / 1e3,
+           percentile(ns, 0.90) / 1e3, percentile(ns, 0.99) / 1e3, percentile(ns, 0.999) / 1e3,
+           ns.empty() ? 0.0 : ns.back() / 1e3);
+}
+}
+
+int main(int argc, char* argv[])
+{
+    string dataFile = textArg(argc, argv, "data", "");
+    string scriptFile = textArg(argc, argv, "script", "");
+    string recordFile = textArg(argc, argv, "record", "");
+    long long sessions = benchArg(argc, argv, "sessions", 10000);
+    int threads = max(1, static_cast<int>(benchArg(argc, argv, "threads", 1)));
+    int accountsPerThread = static_cast<int>(benchArg(argc, argv, "accounts", 1000));
+    unsigned seed = static_cast<unsigned>(benchArg(argc, argv, "seed", 7));
+
+    ostringstream discard;
+    streambuf* original = cout.rdbuf(discard.rdbuf());
+    UserManager um;
+    if (!dataFile.empty())
+    {
+        bool snapshot = dataFile.size() > 5 && dataFile.compare(dataFile.size() - 5, 5, ".snap") == 0;
+        if (snapshot) um.loadSnapshot(dataFile);
+        else um.loadFromFile(dataFile);
+    }
+    cout.rdbuf(original);
+    printf("preloaded users: %d\n", um.getTotalUsersCount());
+
+    BatchExecutor executor(um);
+    vector<Latencies> perThread(threads);
+    double seconds = 0;
+
+    if (!scriptFile.empty())
+    {
+        ifstream script(scriptFile);
+        if (!script)
+        {
+            fprintf(stderr, "cannot open %s\n", scriptFile.c_str());
+            return 1;
+        }
+        threads = 1;
+        string line;
+        BenchTimer timer;
+        while (getline(script, line))
+        {
+            runLine(executor, line, perThread[0], nullptr);
+        }
+        seconds = timer.seconds();
+    }
+    else
+    {
+        if (!recordFile.empty()) threads = 1;    // Only one thread replays in a fixed order
+        ofstream record;
+        if (!recordFile.empty()) record.open(recordFile);
+
+        vector<SessionGenerator> generators;
+        generators.reserve(threads);
+        for (int t = 0; t < threads; t++)
+        {
+            generators.emplace_back(executor, perThread[t], record.is_open() ? &record : nullptr, seed + t, t);
+            generators.back().registerAccounts(accountsPerThread);
+        }
+
+        vector<thread> workers;
+        BenchTimer timer;
+        for (int t = 0; t < threads; t++)
+        {
+            long long share = sessions / threads + (t < sessions % threads ? 1 : 0);
+            workers.emplace_back([&generators, t, share]
+            {
+                for (long long s = 0; s < share; s++) generators[t].session();
+            });
+        }
+        for (thread& worker : workers) worker.join();
+        seconds = timer.seconds();
+    }
+
+    // Merge the threads
+    Latencies total;
+    vector<double> all;
+    for (Latencies& latencies : perThread)
+    {
+        total.failed += latencies.failed;
+        total.parseErrors += latencies.parseErrors;
+        for (auto& pair : latencies.byCommand)
+        {
+            vector<double>& merged = total.byCommand[pair.first];
+            merged.insert(merged.end(), pair.second.begin(), pair.second.end());
+            all.insert(all.end(), pair.second.begin(), pair.second.end());
+        }
+    }
+
+    printf("threads: %d, commands: %zu (%lld failed, %lld parse errors), %.2f s, %.0f commands/s\n",
+           threads, all.size(), total.failed, total.parseErrors, seconds, seconds > 0 ? all.size() / seconds : 0.0);
+    printf("%-16s %10s %10s %10s %10s %10s %10s\n", "command", "count", "p50 us", "p90 us", "p99 us", "p99.9 us", "max us");
+    for (auto& pair : total.byCommand)
+    {
+        printRow(pair.first, pair.second);
+    }
+    printRow("all", all);
+
+#ifndef TASK_PLANNER_NO_METRICS
+    // The same run as seen by the built-in histograms (setup and preload included)
+    printf("\nUserManager metrics:\n");
+    fflush(stdout);
+    um.metrics().writeReport(cout);
+    cout.flush();
+#endif
+    return 0;
+}
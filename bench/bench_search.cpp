@@ -0,0 +1,89 @@
+// Partial-match user search: linear scan (the old searchUsers step 4) against the trigram index
+//
+// Build: g++ -std=c++17 -O2 -pthread -o bench_search bench/bench_search.cpp usermanager.cpp snapshot.cpp parallelload.cpp journal.cpp dateutil.cpp taskcolumns.cpp trigramindex.cpp adminview.cpp identityindex.cpp tablerenderer.cpp opmetrics.cpp bulkimport.cpp bulktasks.cpp terminal.cpp taskowners.cpp reminders.cpp blockcodec.cpp
+// Run:   ./bench_search --users 200000 --queries 2000
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include "bench_common.h"
+
+namespace
+{
+// Every user whose ID, username or email contains keyword, ascending IDs
+vector<int> scanUsers(const UserManager& um, const string& keyword)
+{
+    vector<int> ids;
+    um.forEachUser([&](const User& user)
+    {
+        if (to_string(user.id).find(keyword) != string::npos ||
+                user.username.find(keyword) != string::npos ||
+                user.email.find(keyword) != string::npos)
+        {
+            ids.push_back(user.id);
+        }
+    });
+    sort(ids.begin(), ids.end());
+    return ids;
+}
+}
+
+int main(int argc, char* argv[])
+{
+    int users = static_cast<int>(benchArg(argc, argv, "users", 200000));
+    int queries = static_cast<int>(benchArg(argc, argv, "queries", 2000));
+
+    ostringstream sink;
+    streambuf* original = cout.rdbuf(sink.rdbuf());
+    UserManager um;
+    BenchTimer timer;
+    populateUsers(um, users, 0);
+    double populateMs = timer.millis();
+    cout.rdbuf(original);
+
+    // Typo-like keywords: fragments of existing names (past the shared "bench"
+    // prefix, which matches everyone), and fragments that match nobody
+    mt19937 rng(7);
+    vector<string> keywords;
+    for (int q = 0; q < queries; q++)
+    {
+        string name = "bench" + to_string(rng() % users);
+        string tail = name.substr(name.size() >= 7 ? 4 : 3);
+        size_t len = 3 + rng() % (tail.size() - 2);
+        string keyword = tail.substr(rng() % (tail.size() - len + 1), len);
+        if (q % 4 == 3) keyword += "zq";
+        keywords.push_back(keyword);
+    }
+
+    size_t scanHits = 0, indexHits = 0;
+    bool mismatch = false;
+
+    timer.reset();
+    for (const string& keyword : keywords) scanHits += scanUsers(um, keyword).size();
+    double scanMs = timer.millis();
+
+    timer.reset();
+    for (const string& keyword : keywords)
+    {
+        size_t total = 0;
+        um.findUsersMatching(keyword, 20, &total);
+        indexHits += total;
+    }
+    double indexMs = timer.millis();
+
+    // Full result sets must agree, not only the counts
+    for (size_t q = 0; q < keywords.size() && q < 200; q++)
+    {
+        vector<int> ranked = um.findUsersMatching(keywords[q], SIZE_MAX);
+        sort(ranked.begin(), ranked.end());
+        if (ranked != scanUsers(um, keywords[q])) mismatch = true;
+    }
+
+    printf("users: %d, queries: %d (populate incl. index %.0f ms)\n", users, queries, populateMs);
+    printf("%-16s %12s %12s\n", "search", "us/query", "matches");
+    printf("%-16s %12.1f %12zu\n", "linear scan", scanMs * 1000 / queries, scanHits);
+    printf("%-16s %12.1f %12zu\n", "trigram index", indexMs * 1000 / queries, indexHits);
+    printf("speedup: %.1fx%s\n", scanMs / indexMs, (mismatch || scanHits != indexHits) ? "  MISMATCH" : "");
+    return 0;
+}
@@ -0,0 +1,156 @@
+// Primary user store: the old layout (hash map userId -> User plus an ordered
+// map userId -> User* for ID-order listings) against the dense UserSlots store.
+// Build time, random lookups by ID, a full sweep in ID order, and delete +
+// re-add churn, each with shard pools as in UserManager. Then getUser and
+// forEachUserById on a populated UserManager.
+//
+// Build: g++ -std=c++17 -O2 -DNDEBUG -pthread -o bench_slots bench/bench_slots.cpp usermanager.cpp snapshot.cpp parallelload.cpp journal.cpp dateutil.cpp taskcolumns.cpp trigramindex.cpp adminview.cpp identityindex.cpp tablerenderer.cpp opmetrics.cpp bulkimport.cpp bulktasks.cpp terminal.cpp taskowners.cpp reminders.cpp blockcodec.cpp
+// Run:   ./bench_slots --users 1000000 --lookups 5000000
+#include <cstdio>
+#include <map>
+#include <memory_resource>
+#include <random>
+#include <unordered_map>
+#include <vector>
+#include "bench_common.h"
+
+namespace
+{
+const int FIRST_ID = 101;
+
+struct Cost
+{
+    double buildMs;
+    double hitNs;
+    double missNs;
+    double sweepNs;      // Per user
+    double churnNs;      // Per delete + re-add
+};
+
+// The containers UserManager kept before the slot store
+struct OldStore
+{
+    pmr::unsynchronized_pool_resource pool;
+    pmr::unordered_map<int, User> users{ &pool };
+    map<int, User*> usersInIdOrder;
+
+    User* find(int id)
+    {
+        auto it = users.find(id);
+        return it != users.end() ? &it->second : nullptr;
+    }
+    User& insert(int id)
+    {
+        User& user = users[id];
+        usersInIdOrder[id] = &user;
+        return user;
+    }
+    void erase(int id)
+    {
+        usersInIdOrder.erase(id);
+        users.erase(id);
+    }
+    template <typename Fn>
+    void forEachById(Fn fn) const
+    {
+        for (const auto& pair : usersInIdOrder) fn(*pair.second);
+    }
+};
+
+struct SlotStore
+{
+    pmr::unsynchronized_pool_resource pool;
+    UserSlots users{ 1, &pool };
+
+    User* find(int id) { return users.find(id); }
+    User& insert(int id) { return users.insert(id); }
+    void erase(int id) { users.erase(id); }
+    template <typename Fn>
+    void forEachById(Fn fn) const { users.forEach(fn); }
+};
+
+template <typename Store>
+Cost measure(int userCount, const vector<int>& hits, const vector<int>& misses, const vector<int>& churn)
+{
+    Cost cost;
+    Store store;
+    BenchTimer timer;
+    for (int i = 0; i < userCount; i++)
+    {
+        int id = FIRST_ID + i;
+        User& user = store.insert(id);
+        user = User(id, "user" + to_string(i), "user" + to_string(i) + "@mail.com", "pass");
+    }
+    cost.buildMs = timer.millis();
+
+    long long sink = 0;
+    timer.reset();
+    for (int id : hits) sink += store.find(id)->id;
+    cost.hitNs = timer.seconds() * 1e9 / hits.size();
+
+    timer.reset();
+    for (int id : misses) sink += store.find(id) != nullptr;
+    cost.missNs = timer.seconds() * 1e9 / misses.size();
+
+    timer.reset();
+    int previous = 0;
+    bool ordered = true;
+    store.forEachById([&](const User& user)
+    {
+        ordered = ordered && user.id > previous;
+        previous = user.id;
+        sink += user.username.size();
+    });
+    cost.sweepNs = timer.seconds() * 1e9 / userCount;
+    if (!ordered) printf("not in ID order!\n");
+
+    timer.reset();
+    for (int id : churn)
+    {
+        store.erase(id);
+        User& user = store.insert(id);
+        user = User(id, "again", "again@mail.com", "pass");
+    }
+    cost.churnNs = timer.seconds() * 1e9 / churn.size();
+
+    if (sink == 42) printf(" ");
+    return cost;
+}
+
+void printRow(const char* label, const Cost& c)
+{
+    printf("%-22s %10.1f %10.1f %10.1f %12.1f %12.1f\n", label, c.buildMs, c.hitNs, c.missNs, c.sweepNs, c.churnNs);
+}
+}
+
+int main(int argc, char* argv[])
+{
+    int users = static_cast<int>(benchArg(argc, argv, "users", 1000000));
+    int lookups = static_cast<int>(benchArg(argc, argv, "lookups", 5000000));
+
+    mt19937 rng(7);
+    vector<int> hits(lookups), misses(lookups), churn(lookups / 10);
+    for (int& id : hits) id = FIRST_ID + static_cast<int>(rng() % users);
+    for (int& id : misses) id = FIRST_ID + users + static_cast<int>(rng() % users);
+    for (int& id : churn) id = FIRST_ID + static_cast<int>(rng() % users);
+
+    printf("%d users, %d lookups\n", users, lookups);
+    printf("%-22s %10s %10s %10s %12s %12s\n", "store", "build ms", "hit ns", "miss ns", "sweep ns/u", "churn ns");
+    printRow("hash map + id map", measure<OldStore>(users, hits, misses, churn));
+    printRow("UserSlots", measure<SlotStore>(users, hits, misses, churn));
+
+    // The real thing: 4 shards, IDs from registration
+    UserManager um(4);
+    populateUsers(um, users, 0);
+    long long sink = 0;
+    BenchTimer timer;
+    for (int id : hits) sink += um.getUser(id) != nullptr;
+    double getNs = timer.seconds() * 1e9 / hits.size();
+
+    timer.reset();
+    um.forEachUserById([&](const User& user) { sink += user.id; });
+    double sweepNs = timer.seconds() * 1e9 / users;
+    printf("\nUserManager(4 shards): getUser %.1f ns, forEachUserById %.1f ns per user (%lld)\n",
+           getNs, sweepNs, sink % 10);
+    return 0;
+}
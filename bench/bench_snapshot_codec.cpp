@@ -0,0 +1,97 @@
+// Persisted size and save/load speed of the generator data set in each format:
+// the data.txt text export, the fixed-width snapshot (version 1) and the compact
+// snapshot (version 2) with and without block compression. MB/s is measured
+// against the text size, so the columns compare the same data across formats.
+//
+// Build: g++ -std=c++17 -O2 -DNDEBUG -pthread -o bench_snapshot_codec bench/bench_snapshot_codec.cpp usermanager.cpp snapshot.cpp parallelload.cpp journal.cpp dateutil.cpp taskcolumns.cpp trigramindex.cpp adminview.cpp identityindex.cpp tablerenderer.cpp opmetrics.cpp bulkimport.cpp bulktasks.cpp terminal.cpp taskowners.cpp reminders.cpp blockcodec.cpp
+// Run:   ./bench_snapshot_codec --users 100000 --tasks 20
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+#include "bench_common.h"
+#include "bench_dataset.h"
+
+namespace
+{
+long long fileSize(const string& path)
+{
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file) return 0;
+    fseek(file, 0, SEEK_END);
+    long long size = ftell(file);
+    fclose(file);
+    return size;
+}
+}
+
+int main(int argc, char* argv[])
+{
+    DatasetOptions options;
+    options.users = static_cast<int>(benchArg(argc, argv, "users", 100000));
+    options.meanTasks = static_cast<double>(benchArg(argc, argv, "tasks", 20));
+    int rounds = static_cast<int>(benchArg(argc, argv, "rounds", 3));
+    string textPath = "bench_codec_data.txt";
+
+    DatasetStats stats = writeTextDataset(textPath, options);
+    if (stats.users == 0)
+    {
+        fprintf(stderr, "cannot write %s\n", textPath.c_str());
+        return 1;
+    }
+
+    // Silence the save/load status lines while timing
+    ostringstream discard;
+    streambuf* original = cout.rdbuf(discard.rdbuf());
+
+    UserManager source;
+    source.loadFromFile(textPath);
+    double textMB = stats.bytes / 1e6;
+
+    struct Format {
+        const char* name;
+        string path;
+        bool text;
+        SnapshotEncoding encoding;
+    };
+    const Format formats[] = {
+        { "text (data.txt)", textPath, true, SnapshotEncoding::Fixed },
+        { "fixed snapshot (v1)", "bench_codec.v1", false, SnapshotEncoding::Fixed },
+        { "compact (v2)", "bench_codec.v2", false, SnapshotEncoding::Compact },
+        { "compact + blocks (v2)", "bench_codec.v2z", false, SnapshotEncoding::Compressed },
+    };
+
+    string report;
+    char line[160];
+    for (const Format& format : formats)
+    {
+        double saveMs = 1e300, loadMs = 1e300;
+        long long tasks = 0;
+        for (int r = 0; r < rounds; r++)
+        {
+            BenchTimer timer;
+            if (format.text) source.saveToFile(format.path);
+            else source.saveSnapshot(format.path, format.encoding);
+            saveMs = min(saveMs, timer.millis());
+
+            UserManager loaded;
+            timer.reset();
+            if (format.text) loaded.loadFromFile(format.path);
+            else loaded.loadSnapshot(format.path);
+            loadMs = min(loadMs, timer.millis());
+            tasks = loaded.getTotalTasksCount();
+        }
+
+        long long bytes = fileSize(format.path);
+        snprintf(line, sizeof(line), "%-24s %12lld %7.2fx %10.1f %10.1f %10lld\n", format.name, bytes,
+                 static_cast<double>(stats.bytes) / bytes, textMB / (saveMs / 1000), textMB / (loadMs / 1000), tasks);
+        report += line;
+        if (!format.text) remove(format.path.c_str());
+    }
+    remove(textPath.c_str());
+
+    cout.rdbuf(original);
+    printf("%lld users, %lld tasks, text %.1f MB\n", stats.users, stats.tasks, textMB);
+    printf("%-24s %12s %8s %10s %10s %10s\n", "format", "bytes", "ratio", "save MB/s", "load MB/s", "tasks");
+    printf("%s", report.c_str());
+    return 0;
+}
@@ -0,0 +1,163 @@
+// Microbenchmark suite over the UserManager hot paths at several user counts.
+// Prints one JSON object per line (size, operation, ns/op, heap allocations
+// and bytes per op, peak RSS so far) for tracking regressions between builds.
+//
+// Build: g++ -std=c++17 -O2 -pthread -o bench_suite bench/bench_suite.cpp usermanager.cpp snapshot.cpp parallelload.cpp journal.cpp dateutil.cpp taskcolumns.cpp trigramindex.cpp adminview.cpp identityindex.cpp tablerenderer.cpp opmetrics.cpp bulkimport.cpp bulktasks.cpp terminal.cpp taskowners.cpp reminders.cpp blockcodec.cpp
+// Run:   ./bench_suite --sizes 1000,100000,1000000 --tasks 5 --queries 100000 > results.jsonl
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include "bench_alloc.h"
+#include "bench_common.h"
+
+namespace
+{
+#ifdef _WIN32
+const char NULL_FILE[] = "NUL";
+#else
+const char NULL_FILE[] = "/dev/null";
+#endif
+
+// Comma separated list option: --name 1000,100000
+vector<long long> benchList(int argc, char* argv[], const string& name, const string& fallback)
+{
+    string text = fallback;
+    for (int i = 1; i + 1 < argc; i++)
+    {
+        if (argv[i] == "--" + name) text = argv[i + 1];
+    }
+
+    vector<long long> values;
+    stringstream items(text);
+    string item;
+    while (getline(items, item, ','))
+    {
+        if (!item.empty()) values.push_back(atoll(item.c_str()));
+    }
+    return values;
+}
+
+// Runs fn once, which performs `ops` operations, and prints one result line.
+// unit names what one op is: a call, or one row / user of a whole-set operation.
+template <typename Fn>
+void run(int users, int tasks, const char* op, const char* unit, long long ops, Fn fn)
+{
+    size_t count = allocCount, bytes = allocBytes;
+    BenchTimer timer;
+    fn();
+    double seconds = timer.seconds();
+    double perOp = ops > 0 ? 1.0 / ops : 0;
+    printf("{\"users\":%d,\"tasks_per_user\":%d,\"op\":\"%s\",\"unit\":\"%s\",\"ops\":%lld,"
+           "\"ns_per_op\":%.1f,\"allocs_per_op\":%.2f,\"bytes_per_op\":%.1f,\"peak_rss_mb\":%.1f}\n",
+           users, tasks, op, unit, ops, seconds * 1e9 * perOp, (allocCount - count) * perOp,
+           (allocBytes - bytes) * perOp, peakRssMb());
+    fflush(stdout);
+}
+
+void runSize(int users, int tasks, long long queries)
+{
+    string path = "bench_suite_data.txt";
+    ofstream nullFile(NULL_FILE);
+    long long probes = min<long long>(queries, users);
+    mt19937 rng(11);
+    auto name = [](long long i) { return "suite" + to_string(i); };
+
+    UserManager um;
+    run(users, tasks, "addUser", "call", users, [&]
+    {
+        for (int u = 0; u < users; u++)
+        {
+            um.addUser(name(u), name(u) + "@mail.com", "pass" + to_string(u));
+        }
+    });
+
+    // Every user, the sample accounts included, in ID order
+    vector<int> ids;
+    ids.reserve(users);
+    um.forEachUserById([&](const User& user) { ids.push_back(user.id); });
+    run(users, tasks, "createTask", "call", static_cast<long long>(ids.size()) * tasks, [&]
+    {
+        for (int id : ids)
+        {
+            for (int t = 0; t < tasks; t++)
+            {
+                um.createTask(id, "Suite task " + to_string(t), benchDate(rng()));
+            }
+        }
+    });
+
+    vector<long long> picks(probes);
+    for (auto& pick : picks) pick = rng() % users;
+
+    run(users, tasks, "authenticateUser", "call", probes, [&]
+    {
+        for (long long p : picks) um.authenticateUser(name(p), "pass" + to_string(p));
+    });
+    run(users, tasks, "isUsernameUnique", "call", probes, [&]
+    {
+        // Half taken names, half free ones
+        for (long long i = 0; i < probes; i++)
+        {
+            um.isUsernameUnique(i % 2 ? name(picks[i]) : "free" + to_string(i));
+        }
+    });
+
+    streambuf* original = cout.rdbuf(nullFile.rdbuf());
+    long long searches = min<long long>(probes, 10000);
+    run(users, tasks, "searchUsers_exact", "call", searches, [&]
+    {
+        for (long long i = 0; i < searches; i++) um.searchUsers(name(picks[i]));
+    });
+    run(users, tasks, "searchUsers_partial", "call", searches, [&]
+    {
+        // Tail of a username: not an exact key, so the trigram path ranks the matches
+        for (long long i = 0; i < searches; i++)
+        {
+            string full = name(picks[i]);
+            um.searchUsers(full.substr(full.size() - min<size_t>(full.size(), 4)));
+        }
+    });
+    long long dashboards = min<long long>(searches, 1000);
+    run(users, tasks, "showAdminDashboard", "call", dashboards, [&]
+    {
+        // One account change per call, so each dashboard folds a changed user into the view
+        for (long long i = 0; i < dashboards; i++)
+        {
+            um.setUserActive(ids[picks[i] % ids.size()], i % 2 == 0);
+            um.showAdminDashboard();
+        }
+    });
+    run(users, tasks, "viewAllUsers_render", "row", um.getTotalUsersCount(), [&]
+    {
+        UserCursor cursor;
+        um.writeUserPage(cout, cursor);
+        cout.flush();
+    });
+    run(users, tasks, "saveToFile", "user", um.getTotalUsersCount(), [&] { um.saveToFile(path); });
+    {
+        UserManager loaded;
+        run(users, tasks, "loadFromFile", "user", um.getTotalUsersCount(), [&] { loaded.loadFromFile(path); });
+    }
+    cout.rdbuf(original);
+    remove(path.c_str());
+}
+}
+
+int main(int argc, char* argv[])
+{
+    int tasks = static_cast<int>(benchArg(argc, argv, "tasks", 5));
+    long long queries = benchArg(argc, argv, "queries", 100000);
+
+    // Ascending sizes, so peak_rss_mb of a size is not hidden by a larger one
+    vector<long long> sizes = benchList(argc, argv, "sizes", "1000,100000,1000000");
+    sort(sizes.begin(), sizes.end());
+    for (long long size : sizes)
+    {
+        runSize(static_cast<int>(size), tasks, queries);
+    }
+    return 0;
+}
@@ -0,0 +1,55 @@
+// "Who owns task N?": a scan of every user's task map (all findTaskById
+// can do without the owner) against findTask through the global task owner
+// index.
+//
+// Build: g++ -std=c++17 -O2 -DNDEBUG -pthread -o bench_task_owner bench/bench_task_owner.cpp usermanager.cpp snapshot.cpp parallelload.cpp journal.cpp dateutil.cpp taskcolumns.cpp trigramindex.cpp adminview.cpp identityindex.cpp tablerenderer.cpp opmetrics.cpp bulkimport.cpp bulktasks.cpp terminal.cpp taskowners.cpp reminders.cpp blockcodec.cpp
+// Run:   ./bench_task_owner --users 100000 --tasks 10 --lookups 1000000
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "bench_common.h"
+
+int main(int argc, char* argv[])
+{
+    int users = static_cast<int>(benchArg(argc, argv, "users", 100000));
+    int tasksPerUser = static_cast<int>(benchArg(argc, argv, "tasks", 10));
+    int lookups = static_cast<int>(benchArg(argc, argv, "lookups", 1000000));
+    int scans = static_cast<int>(benchArg(argc, argv, "scans", 200));
+
+    UserManager um(4);
+    long long tasks = populateUsers(um, users, tasksPerUser);
+
+    mt19937 rng(3);
+    vector<int> probes(lookups);
+    for (int& id : probes) id = 1001 + static_cast<int>(rng() % tasks);
+
+    // Scan: every user until the owner turns up
+    long long sink = 0;
+    BenchTimer timer;
+    for (int i = 0; i < scans; i++)
+    {
+        int taskId = probes[i];
+        int owner = 0;
+        um.forEachUserById([&](const User& user)
+        {
+            if (!owner && user.tasks.count(taskId)) owner = user.id;
+        });
+        sink += owner;
+    }
+    double scanUs = timer.seconds() * 1e6 / scans;
+
+    timer.reset();
+    for (int taskId : probes)
+    {
+        int owner = 0;
+        um.findTask(taskId, &owner);
+        sink += owner;
+    }
+    double indexNs = timer.seconds() * 1e9 / lookups;
+
+    printf("%d users x %d tasks (%lld tasks)\n", users, tasksPerUser, tasks);
+    printf("%-28s %14.1f us per lookup\n", "scan every user", scanUs);
+    printf("%-28s %14.1f ns per lookup\n", "findTask (owner index)", indexNs);
+    printf("speedup %.0fx (%lld)\n", scanUs * 1000 / indexNs, sink % 10);
+    return 0;
+}
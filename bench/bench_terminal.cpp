@@ -0,0 +1,202 @@
+// Menu interaction latency with scripted input: clearing with system("cls")
+// and printing the menu line by line, against the Terminal layer (ANSI clear,
+// diff redraw, one write per screen). Then the real admin menu driven by a
+// script through the Terminal. Screens go to a sink that counts writes.
+//
+// Build: g++ -std=c++17 -O2 -DNDEBUG -pthread -o bench_terminal bench/bench_terminal.cpp usermanager.cpp snapshot.cpp parallelload.cpp journal.cpp dateutil.cpp taskcolumns.cpp trigramindex.cpp adminview.cpp identityindex.cpp tablerenderer.cpp opmetrics.cpp bulkimport.cpp bulktasks.cpp terminal.cpp taskowners.cpp reminders.cpp blockcodec.cpp
+// Run:   ./bench_terminal --interactions 2000 --users 1000
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "bench_common.h"
+#include "../terminal.h"
+
+namespace
+{
+#ifdef _WIN32
+const char SHELL_CLEAR[] = "cls";
+#else
+const char SHELL_CLEAR[] = "cls 2>/dev/null";   // What the menus ran: a shell that fails to find cls
+#endif
+
+// Output device stand-in: drops the bytes, counts them and the writes (flushes)
+class SinkBuffer : public streambuf {
+public:
+    size_t bytes = 0;
+    size_t writes = 0;
+protected:
+    int_type overflow(int_type ch) override { bytes++; return traits_type::not_eof(ch); }
+    streamsize xsputn(const char*, streamsize n) override { bytes += n; return n; }
+    int sync() override { writes++; return 0; }
+};
+
+// Scripted keyboard: hands out one character at a time and timestamps every line read
+class ScriptBuffer : public streambuf {
+public:
+    explicit ScriptBuffer(const string& script) : text(script) {}
+    vector<double> lineTimes;              // Seconds since construction
+protected:
+    int_type underflow() override
+    {
+        if (pos >= text.size()) return traits_type::eof();
+        if (text[pos] == '\n') lineTimes.push_back(clock.seconds());
+        setg(&text[pos], &text[pos], &text[pos] + 1);
+        pos++;
+        return traits_type::to_int_type(text[pos - 1]);
+    }
+private:
+    string text;
+    size_t pos = 0;
+    BenchTimer clock;
+};
+
+string taskMenu(int interaction)
+{
+    ostringstream frame;
+    frame << "\n--------- TASK MANAGEMENT ---------\n";
+    frame << "User: bench0\n";
+    frame << "Total Tasks: " << 20 + interaction << " | Completed: " << interaction / 2
+          << " | Ongoing: " << 20 + interaction - interaction / 2 << "\n";
+    frame << "\n1. Add New Task\n2. View All Tasks\n3. Edit Task\n4. Mark Task as Completed\n"
+             "5. Delete Task\n6. View Task Details\n7. Upcoming & Overdue Tasks\n8. Bulk Actions\n"
+             "9. Back to Dashboard\nEnter your choice: ";
+    return frame.str();
+}
+
+// One interaction: the menu, a choice, three lines of result, "Press Enter"
+void respond(istream& in, ostream& out)
+{
+    string line;
+    getline(in, line);
+    out << "\nTask added successfully!" << endl;
+    out << "Task ID: 1001" << endl;
+    out << "Status: Ongoing" << endl;
+    out << "\nPress Enter to continue...";
+    getline(in, line);
+}
+
+string script(int interactions)
+{
+    string text;
+    for (int i = 0; i < interactions; i++) text += "1\n\n";
+    return text;
+}
+
+struct Stats {
+    double p50us, p99us, meanUs;
+    double writes, bytes;
+};
+
+Stats summarize(vector<double> us, size_t writes, size_t bytes, int interactions)
+{
+    double total = 0;
+    for (double v : us) total += v;
+    sort(us.begin(), us.end());
+    auto at = [&](double q) { return us[min(us.size() - 1, static_cast<size_t>(q * (us.size() - 1) + 0.5))]; };
+    return { at(0.50), at(0.99), total / us.size(),
+             static_cast<double>(writes) / interactions, static_cast<double>(bytes) / interactions };
+}
+
+void print(const char* path, const Stats& s)
+{
+    printf("%-28s %10.2f %10.2f %10.2f %10.1f %10.0f\n", path, s.p50us, s.p99us, s.meanUs, s.writes, s.bytes);
+}
+
+// Old menus: clear through the shell, one flushed line at a time
+Stats shellClear(int interactions)
+{
+    istringstream in(script(interactions));
+    SinkBuffer sink;
+    ostream out(&sink);
+    vector<double> us;
+    for (int i = 0; i < interactions; i++)
+    {
+        BenchTimer timer;
+        if (system(SHELL_CLEAR) < 0) perror("system");
+        istringstream menu(taskMenu(i));
+        string line;
+        while (getline(menu, line))
+        {
+            if (menu.eof()) out << line;       // The prompt keeps the cursor on its line
+            else out << line << endl;
+        }
+        respond(in, out);
+        us.push_back(timer.seconds() * 1e6);
+    }
+    return summarize(us, sink.writes, sink.bytes, interactions);
+}
+
+// Terminal layer: present() diffs against the menu still on screen
+Stats terminalFrames(int interactions)
+{
+    istringstream in(script(interactions));
+    SinkBuffer sink;
+    ostream out(&sink);
+    vector<double> us;
+    {
+        Terminal terminal(in, out);
+        terminal.setAnsi(true);
+        terminal.setSize(40, 120);
+        terminal.setInputEcho(true);
+        terminal.clear();
+        for (int i = 0; i < interactions; i++)
+        {
+            BenchTimer timer;
+            terminal.present(taskMenu(i));
+            respond(in, out);
+            us.push_back(timer.seconds() * 1e6);
+        }
+    }
+    return summarize(us, sink.writes, sink.bytes, interactions);
+}
+}
+
+int main(int argc, char* argv[])
+{
+    int interactions = static_cast<int>(benchArg(argc, argv, "interactions", 2000));
+    int users = static_cast<int>(benchArg(argc, argv, "users", 1000));
+
+    printf("%d interactions (menu, choice, result, Enter)\n", interactions);
+    printf("%-28s %10s %10s %10s %10s %10s\n", "path", "p50 us", "p99 us", "mean us", "writes", "bytes");
+    print("system(cls) + endl lines", shellClear(interactions));
+    print("Terminal present", terminalFrames(interactions));
+
+    // The real admin menu: alternate an invalid choice (redraw only) and the
+    // task analytics screen (clear, report), each followed by Enter
+    UserManager um;
+    populateUsers(um, users, 10);
+    string text;
+    for (int i = 0; i < interactions; i++) text += i % 2 ? "6\n\n" : "0\n\n";
+    text += "11\n";
+
+    ScriptBuffer keys(text);
+    SinkBuffer sink;
+    streambuf* realIn = cin.rdbuf(&keys);
+    streambuf* realOut = cout.rdbuf(&sink);
+    size_t writes = 0;
+    {
+        Terminal terminal;
+        terminal.setAnsi(true);
+        terminal.setSize(40, 120);
+        terminal.setInputEcho(true);
+        um.attachTerminal(&terminal);
+        um.adminDashboardMenu();
+        um.attachTerminal(nullptr);
+        writes = terminal.writeCount();
+    }
+    cin.rdbuf(realIn);
+    cout.rdbuf(realOut);
+
+    vector<double> us;
+    for (size_t i = 1; i < keys.lineTimes.size(); i++)
+    {
+        us.push_back((keys.lineTimes[i] - keys.lineTimes[i - 1]) * 1e6);
+    }
+    printf("\nadminDashboardMenu, %d users x 10 tasks, per line of input\n", users);
+    printf("%-28s %10s %10s %10s %10s %10s\n", "path", "p50 us", "p99 us", "mean us", "writes", "bytes");
+    print("Terminal, admin menu", summarize(us, writes, sink.bytes, static_cast<int>(us.size())));
+    return 0;
+}
@@ -0,0 +1,94 @@
+// Ordered user listing and text save: copy-and-sort (the old viewAllUsers/saveToFile)
+// against iteration over the ID-ordered index
+//
+// Build: g++ -std=c++17 -O2 -pthread -o bench_views bench/bench_views.cpp usermanager.cpp snapshot.cpp parallelload.cpp journal.cpp dateutil.cpp taskcolumns.cpp trigramindex.cpp adminview.cpp identityindex.cpp tablerenderer.cpp opmetrics.cpp bulkimport.cpp bulktasks.cpp terminal.cpp taskowners.cpp reminders.cpp blockcodec.cpp
+// Run:   ./bench_views --users 100000 --tasks 50
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include "bench_alloc.h"
+#include "bench_common.h"
+
+namespace
+{
+// Discards everything written to it
+class NullBuffer : public streambuf
+{
+protected:
+    int overflow(int c) override { return c; }
+    streamsize xsputn(const char*, streamsize n) override { return n; }
+};
+
+struct Measurement
+{
+    double ms;
+    size_t allocations;
+    size_t bytes;
+};
+
+template <typename Fn>
+Measurement measure(Fn fn)
+{
+    size_t count = allocCount, bytes = allocBytes;
+    BenchTimer timer;
+    fn();
+    return { timer.millis(), allocCount - count, allocBytes - bytes };
+}
+
+// The listing as it was: deep copy of every User (tasks included), then sort
+void copyAndSortListing(const UserManager& um, ostream& out)
+{
+    vector<User> sortedUsers;
+    um.forEachUser([&](const User& user)
+    {
+        sortedUsers.push_back(user);
+    });
+    sort(sortedUsers.begin(), sortedUsers.end(), [](const User& a, const User& b)
+    {
+        return a.id < b.id;
+    });
+    for (const auto& user : sortedUsers)
+    {
+        out << user.id << user.username << user.email << (user.isActive ? "Active" : "Inactive") << "\n";
+    }
+}
+
+void printRow(const char* label, const Measurement& m)
+{
+    printf("%-28s %10.1f %12zu %12.1f\n", label, m.ms, m.allocations, m.bytes / 1e6);
+}
+}
+
+int main(int argc, char* argv[])
+{
+    int users = static_cast<int>(benchArg(argc, argv, "users", 100000));
+    int tasks = static_cast<int>(benchArg(argc, argv, "tasks", 50));
+    string path = "bench_views_data.txt";
+
+    NullBuffer nullBuffer;
+    ostream nullStream(&nullBuffer);
+    streambuf* original = cout.rdbuf(&nullBuffer);
+
+    UserManager um;
+    long long created = populateUsers(um, users, tasks);
+
+    Measurement copyList = measure([&] { copyAndSortListing(um, nullStream); });
+    Measurement viewAll = measure([&]
+    {
+        UserCursor cursor;
+        um.writeUserPage(cout, cursor);
+    });
+    Measurement save = measure([&] { um.saveToFile(path); });
+    cout.rdbuf(original);
+    remove(path.c_str());
+
+    printf("users: %d, tasks: %lld\n", users, created);
+    printf("%-28s %10s %12s %12s\n", "operation", "ms", "allocations", "MB allocated");
+    printRow("copy + sort listing (old)", copyList);
+    printRow("user listing (admin view)", viewAll);
+    printRow("saveToFile (ordered index)", save);
+    return 0;
+}
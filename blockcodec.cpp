@@ -0,0 +1,146 @@
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "blockcodec.h"
+
+namespace
+{
+const size_t MIN_MATCH = 4;
+const size_t MAX_OFFSET = 65535;
+const int HASH_BITS = 14;
+
+inline uint32_t read32(const unsigned char* p)
+{
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline uint32_t hash4(uint32_t v)
+{
+    return (v * 2654435761u) >> (32 - HASH_BITS);
+}
+
+// Length beyond the 15 in the token: 255s, then the remainder
+inline unsigned char* writeLength(unsigned char* out, size_t length)
+{
+    for (; length >= 255; length -= 255) *out++ = 255;
+    *out++ = static_cast<unsigned char>(length);
+    return out;
+}
+
+inline bool readLength(const unsigned char*& in, const unsigned char* end, size_t& length)
+{
+    unsigned char b;
+    do
+    {
+        if (in == end) return false;
+        b = *in++;
+        length += b;
+    } while (b == 255);
+    return true;
+}
+
+unsigned char* writeSequence(unsigned char* out, const unsigned char* literals, size_t literalCount,
+                             size_t matchLength, size_t offset)
+{
+    unsigned char* token = out++;
+    *token = static_cast<unsigned char>((literalCount >= 15 ? 15 : literalCount) << 4);
+    if (literalCount >= 15) out = writeLength(out, literalCount - 15);
+    memcpy(out, literals, literalCount);
+    out += literalCount;
+
+    if (matchLength == 0) return out;                    // Last sequence
+    *out++ = static_cast<unsigned char>(offset);
+    *out++ = static_cast<unsigned char>(offset >> 8);
+    size_t code = matchLength - MIN_MATCH;
+    *token |= static_cast<unsigned char>(code >= 15 ? 15 : code);
+    if (code >= 15) out = writeLength(out, code - 15);
+    return out;
+}
+}
+
+size_t compressBound(size_t size)
+{
+    return size + size / 255 + 16;
+}
+
+size_t compressBlock(const char* src, size_t size, char* dst)
+{
+    const unsigned char* in = reinterpret_cast<const unsigned char*>(src);
+    unsigned char* out = reinterpret_cast<unsigned char*>(dst);
+    vector<uint32_t> table(size_t(1) << HASH_BITS, 0);  // Last position of each hashed 4-byte prefix
+
+    size_t anchor = 0;                                   // Start of the pending literals
+    size_t pos = 0;
+    while (pos + MIN_MATCH <= size)
+    {
+        uint32_t seq = read32(in + pos);
+        uint32_t& slot = table[hash4(seq)];
+        size_t candidate = slot;
+        slot = static_cast<uint32_t>(pos);
+
+        if (candidate >= pos || pos - candidate > MAX_OFFSET || read32(in + candidate) != seq)
+        {
+            pos += 1 + ((pos - anchor) >> 6);            // Skip faster through data that does not match
+            continue;
+        }
+
+        size_t length = MIN_MATCH;
+        while (pos + length < size && in[candidate + length] == in[pos + length]) length++;
+
+        out = writeSequence(out, in + anchor, pos - anchor, length, pos - candidate);
+        pos += length;
+        anchor = pos;
+        if (pos >= 2 && pos + MIN_MATCH <= size + 2)
+        {
+            table[hash4(read32(in + pos - 2))] = static_cast<uint32_t>(pos - 2);
+        }
+    }
+
+    out = writeSequence(out, in + anchor, size - anchor, 0, 0);
+    return static_cast<size_t>(out - reinterpret_cast<unsigned char*>(dst));
+}
+
+bool decompressBlock(const char* src, size_t size, char* dst, size_t rawSize)
+{
+    const unsigned char* in = reinterpret_cast<const unsigned char*>(src);
+    const unsigned char* inEnd = in + size;
+    unsigned char* out = reinterpret_cast<unsigned char*>(dst);
+    unsigned char* const outStart = out;
+    unsigned char* const outEnd = out + rawSize;
+
+    while (in < inEnd)
+    {
+        unsigned char token = *in++;
+        size_t literalCount = token >> 4;
+        if (literalCount == 15 && !readLength(in, inEnd, literalCount)) return false;
+        if (literalCount > static_cast<size_t>(inEnd - in) || literalCount > static_cast<size_t>(outEnd - out)) return false;
+        memcpy(out, in, literalCount);
+        in += literalCount;
+        out += literalCount;
+        if (in == inEnd) break;                          // Last sequence
+
+        if (inEnd - in < 2) return false;
+        size_t offset = in[0] | (static_cast<size_t>(in[1]) << 8);
+        in += 2;
+        if (offset == 0 || offset > static_cast<size_t>(out - outStart)) return false;
+
+        size_t length = token & 15;
+        if (length == 15 && !readLength(in, inEnd, length)) return false;
+        length += MIN_MATCH;
+        if (length > static_cast<size_t>(outEnd - out)) return false;
+
+        const unsigned char* match = out - offset;
+        if (offset >= length)
+        {
+            memcpy(out, match, length);
+            out += length;
+        }
+        else
+        {
+            while (length--) *out++ = *match++;          // Overlapping: repeats the last offset bytes
+        }
+    }
+    return out == outEnd;
+}
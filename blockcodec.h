@@ -0,0 +1,26 @@
+#ifndef BLOCK_CODEC_H
+#define BLOCK_CODEC_H
+
+#include <cstddef>
+using namespace std;
+
+// Fast LZ77 block compressor for the snapshot stream (LZ4-style sequences).
+// A block is a run of sequences: a token byte (high nibble literal count,
+// low nibble match length - 4, 15 = more length bytes follow, each 255 adds
+// on), the literals, then a 2-byte little-endian offset back into the block.
+// The last sequence has literals only. Matches come from a hash table of
+// 4-byte prefixes, so it trades ratio for speed; blocks are independent.
+
+size_t compressBound(size_t size);            // Worst case output for size input bytes
+
+// Most raw bytes one compressed byte can decode to (a 255 match length byte)
+const size_t BLOCK_MAX_EXPANSION = 255;
+
+// Compress size bytes into dst (at least compressBound(size) bytes), returns the length
+size_t compressBlock(const char* src, size_t size, char* dst);
+
+// Decompress into exactly rawSize bytes at dst; false when the input is damaged
+// or does not fill dst exactly. Never reads or writes out of bounds.
+bool decompressBlock(const char* src, size_t size, char* dst, size_t rawSize);
+
+#endif
@@ -0,0 +1,272 @@
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <fstream>
+#include <thread>
+#include "journal.h"
+#include "usermanager.h"
+
+namespace
+{
+// Batches smaller than this are validated on the calling thread
+const size_t PARALLEL_MIN_ROWS = 16384;
+const size_t VALIDATE_CHUNK_ROWS = 4096;
+
+// Split one CSV line into fields: commas separate, "quoted" fields may hold
+// commas and "" for a quote, spaces around unquoted fields are dropped
+bool splitCsvLine(const string& line, vector<string>& fields)
+{
+    fields.clear();
+    size_t i = 0;
+    while (true)
+    {
+        while (i < line.size() && (line[i] == ' ' || line[i] == '\t')) i++;
+
+        string field;
+        if (i < line.size() && line[i] == '"')
+        {
+            i++;
+            while (true)
+            {
+                if (i >= line.size()) return false;           // Unterminated quote
+                if (line[i] == '"')
+                {
+                    if (i + 1 < line.size() && line[i + 1] == '"')
+                    {
+                        field += '"';
+                        i += 2;
+                        continue;
+                    }
+                    i++;
+                    break;
+                }
+                field += line[i++];
+            }
+            while (i < line.size() && (line[i] == ' ' || line[i] == '\t')) i++;
+            if (i < line.size() && line[i] != ',') return false;
+        }
+        else
+        {
+            size_t start = i;
+            while (i < line.size() && line[i] != ',') i++;
+            size_t end = i;
+            while (end > start && isspace(static_cast<unsigned char>(line[end - 1]))) end--;
+            field.assign(line, start, end - start);
+        }
+
+        fields.push_back(move(field));
+        if (i >= line.size()) return true;
+        i++;                                                  // Skip the comma
+    }
+}
+
+bool equalsIgnoreCase(const string& a, const char* b)
+{
+    size_t i = 0;
+    for (; i < a.size() && b[i]; i++)
+    {
+        if (tolower(static_cast<unsigned char>(a[i])) != tolower(static_cast<unsigned char>(b[i]))) return false;
+    }
+    return i == a.size() && !b[i];
+}
+}
+
+ImportReport UserManager::importUsers(const vector<ImportUser>& rows, bool allOrNothing)
+{
+    return importRows(rows, allOrNothing, true);
+}
+
+// importUsers body; commitAllowed = false checks and reports every row but adds none
+ImportReport UserManager::importRows(const vector<ImportUser>& rows, bool allOrNothing, bool commitAllowed)
+{
+    OP_TIMER(Op::ImportUsers);
+    ImportReport report;
+    report.rows = rows.size();
+
+    // Field checks need no lock - split across threads for large batches
+    vector<OpStatus> status(rows.size(), OpStatus::Ok);
+    auto validate = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+        {
+            status[i] = validateNewUser(rows[i].username, rows[i].email, rows[i].password);
+        }
+    };
+    if (rows.size() < PARALLEL_MIN_ROWS)
+    {
+        validate(0, rows.size());
+    }
+    else
+    {
+        size_t chunks = (rows.size() + VALIDATE_CHUNK_ROWS - 1) / VALIDATE_CHUNK_ROWS;
+        atomic<size_t> nextChunk(0);
+        auto worker = [&]() {
+            for (size_t c = nextChunk++; c < chunks; c = nextChunk++)
+            {
+                validate(c * VALIDATE_CHUNK_ROWS, min(rows.size(), (c + 1) * VALIDATE_CHUNK_ROWS));
+            }
+        };
+
+        unsigned threadCount = max(1u, thread::hardware_concurrency());
+        vector<thread> pool;
+        for (unsigned t = 1; t < min<size_t>(threadCount, chunks); t++)
+        {
+            pool.emplace_back(worker);
+        }
+        worker();
+        for (auto& th : pool)
+        {
+            th.join();
+        }
+    }
+
+    // Duplicates inside the batch - the first row with a name keeps it.
+    // The batch index views the rows' own strings, IDs are row + 1.
+    vector<size_t> firstRow(rows.size(), 0);
+    IdentityIndex batch;
+    batch.reserve(rows.size());
+    for (size_t i = 0; i < rows.size(); i++)
+    {
+        if (status[i] != OpStatus::Ok) continue;
+        if (int earlier = batch.findUsername(rows[i].username))
+        {
+            status[i] = OpStatus::UsernameTaken;
+            firstRow[i] = static_cast<size_t>(earlier);
+        }
+        else if (int earlier = batch.findEmail(rows[i].email))
+        {
+            status[i] = OpStatus::EmailTaken;
+            firstRow[i] = static_cast<size_t>(earlier);
+        }
+        else
+        {
+            batch.add(static_cast<int>(i + 1), rows[i].username, rows[i].email);
+        }
+    }
+
+    // Everything else happens under all locks: existing names cannot change
+    // underneath the checks, and the batch becomes visible at once
+    auto locks = lockAll();
+    size_t accepted = 0;
+    for (size_t i = 0; i < rows.size(); i++)
+    {
+        const ImportUser& row = rows[i];
+        if (status[i] == OpStatus::Ok)
+        {
+            if (int existing = identities.findUsername(row.username))
+            {
+                status[i] = OpStatus::UsernameTaken;
+                report.rejected.push_back({ i, status[i], row.username, existing });
+            }
+            else if (int existing = identities.findEmail(row.email))
+            {
+                status[i] = OpStatus::EmailTaken;
+                report.rejected.push_back({ i, status[i], row.email, existing });
+            }
+            else
+            {
+                accepted++;
+            }
+            continue;
+        }
+
+        ImportRejection rejection = { i, status[i], status[i] == OpStatus::UsernameTaken ? row.username : row.email };
+        if (status[i] == OpStatus::InvalidPassword) rejection.value.clear();
+        if (firstRow[i]) rejection.earlierRow = firstRow[i] - 1;
+        report.rejected.push_back(move(rejection));
+    }
+
+    if (accepted == 0 || !commitAllowed || (allOrNothing && !report.rejected.empty()))
+    {
+        return report;
+    }
+
+    // One block of IDs and one reserve per index, then plain inserts
+    reserveUsers(accepted);
+    int nextId = userIdCounter.fetch_add(static_cast<int>(accepted));
+    report.userIds.reserve(accepted);
+    for (size_t i = 0; i < rows.size(); i++)
+    {
+        if (status[i] != OpStatus::Ok) continue;
+
+        const ImportUser& row = rows[i];
+        int id = nextId++;
+        restoreUser(id, row.username, row.email, row.password, row.isActive);
+        if (journal)
+        {
+            journal->logAddUser(id, row.username, row.email, row.password);
+            if (!row.isActive) journal->logSetUserActive(id, false);
+        }
+        report.userIds.push_back(id);
+    }
+    report.committed = true;
+
+#ifndef NDEBUG
+    statisticsConsistent();
+#endif
+    return report;
+}
+
+ImportReport UserManager::importUsersCsv(const string& filename, bool allOrNothing)
+{
+    ifstream file(filename);
+    if (!file.is_open())
+    {
+        ImportReport report;
+        report.status = OpStatus::IoError;
+        return report;
+    }
+
+    // Parse every line first; bad lines are reported with their line number
+    vector<ImportUser> rows;
+    vector<size_t> lineOf;                 // Line number of each row
+    vector<ImportRejection> malformed;
+    vector<string> fields;
+    string line;
+    size_t lineNo = 0;
+    bool firstLine = true;
+    while (getline(file, line))
+    {
+        lineNo++;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.find_first_not_of(" \t") == string::npos) continue;
+
+        bool ok = splitCsvLine(line, fields);
+        if (firstLine && ok && !fields.empty() && equalsIgnoreCase(fields[0], "username"))
+        {
+            firstLine = false;             // Header line
+            continue;
+        }
+        firstLine = false;
+
+        bool validStatus = ok && (fields.size() == 3 || (fields.size() == 4 &&
+                           (equalsIgnoreCase(fields[3], "Active") || equalsIgnoreCase(fields[3], "Inactive"))));
+        if (!validStatus)
+        {
+            malformed.push_back({ lineNo, OpStatus::MalformedRow, line.substr(0, 60) });
+            continue;
+        }
+
+        ImportUser row;
+        row.username = move(fields[0]);
+        row.email = move(fields[1]);
+        row.password = move(fields[2]);
+        row.isActive = fields.size() == 3 || equalsIgnoreCase(fields[3], "Active");
+        rows.push_back(move(row));
+        lineOf.push_back(lineNo);
+    }
+
+    // A malformed line stops an all-or-nothing import, but the other rows are still checked
+    ImportReport report = importRows(rows, allOrNothing, !(allOrNothing && !malformed.empty()));
+
+    // Rows back to line numbers, in file order with the malformed lines
+    for (ImportRejection& rejection : report.rejected)
+    {
+        if (rejection.earlierRow != SIZE_MAX) rejection.earlierRow = lineOf[rejection.earlierRow];
+        rejection.row = lineOf[rejection.row];
+    }
+    report.rows += malformed.size();
+    report.rejected.insert(report.rejected.end(), malformed.begin(), malformed.end());
+    sort(report.rejected.begin(), report.rejected.end(),
+         [](const ImportRejection& a, const ImportRejection& b) { return a.row < b.row; });
+    return report;
+}
@@ -0,0 +1,205 @@
+#include <algorithm>
+#include "journal.h"
+#include "reminders.h"
+#include "usermanager.h"
+
+OpStatus UserManager::completeTasks(int userId, const TaskFilter& filter, size_t* count)
+{
+    OP_TIMER(Op::CompleteTasks);
+    return updateTasks(userId, filter, false, count);
+}
+
+OpStatus UserManager::removeTasks(int userId, const TaskFilter& filter, size_t* count)
+{
+    OP_TIMER(Op::RemoveTasks);
+    return updateTasks(userId, filter, true, count);
+}
+
+// completeTasks / removeTasks body - listed task IDs go straight to their owners
+// through the task index; otherwise one user's index, or every shard's in turn
+OpStatus UserManager::updateTasks(int userId, const TaskFilter& filter, bool remove, size_t* count)
+{
+    vector<int> ids = filter.taskIds;
+    sort(ids.begin(), ids.end());
+    ids.erase(unique(ids.begin(), ids.end()), ids.end());
+
+    // IDs below the task index's range can only be found by walking the indexes
+    bool byId = !ids.empty() && taskOwners.covers(ids.front());
+
+    size_t total = 0;
+    if (userId != 0)
+    {
+        UserShard& shard = shardFor(userId);
+        lock_guard<mutex> guard(shard.lock);
+        User* user = findUserById(userId);
+        if (!user) return OpStatus::UserNotFound;
+        if (byId)
+        {
+            vector<pair<int, int>> tasks;
+            tasks.reserve(ids.size());
+            for (int id : ids) tasks.push_back({ userId, id });
+            total = applyTaskList(shard, filter, tasks, remove);
+        }
+        else
+        {
+            total = applyTaskBatch(shard, user->dueIndex, filter, ids, remove);
+        }
+    }
+    else if (byId)
+    {
+        // Owners are read without a lock; applyTaskList checks each task is still there
+        vector<vector<pair<int, int>>> byShard(shards.size());
+        for (int id : ids)
+        {
+            int owner = taskOwners.owner(id);
+            if (owner != 0) byShard[static_cast<unsigned>(owner) % shards.size()].push_back({ owner, id });
+        }
+        for (size_t i = 0; i < shards.size(); i++)
+        {
+            if (byShard[i].empty()) continue;
+            lock_guard<mutex> guard(shards[i]->lock);
+            total += applyTaskList(*shards[i], filter, byShard[i], remove);
+        }
+    }
+    else
+    {
+        for (auto& shard : shards)
+        {
+            lock_guard<mutex> guard(shard->lock);
+            total += applyTaskBatch(*shard, shard->dueIndex, filter, ids, remove);
+        }
+    }
+
+    if (count) *count = total;
+    return OpStatus::Ok;
+}
+
+// Complete or remove the listed (owner ID, task ID) pairs of one shard, each
+// found in its owner's task map and checked against the status and date filter -
+// O(listed tasks) with no index walk. Caller holds the shard lock.
+size_t UserManager::applyTaskList(UserShard& shard, const TaskFilter& filter,
+                                  const vector<pair<int, int>>& tasks, bool remove)
+{
+    User* user = nullptr;
+    size_t changed = 0;
+    int completedDelta = 0;
+
+    for (const auto& listed : tasks)
+    {
+        if (!user || user->id != listed.first) user = findUserById(listed.first);
+        if (!user) continue;
+        auto found = user->tasks.find(listed.second);
+        if (found == user->tasks.end()) continue;     // Removed, or never this user's
+
+        Task& task = found->second;
+        bool completed = task.status == "Completed";
+        if (task.dueDate < filter.dueFrom || task.dueDate > filter.dueTo) continue;
+        if (completed && (!remove || filter.status == TaskFilter::Status::Ongoing)) continue;
+        if (!completed && filter.status == TaskFilter::Status::Completed) continue;
+
+        DueEntry entry = { completed, task.dueDate, task.taskId, user->id };
+        shard.dueIndex.erase(entry);
+        user->dueIndex.erase(entry);
+        if (reminders) reminders->cancel(entry.taskId);
+
+        if (remove)
+        {
+            if (completed)
+            {
+                user->completedCount--;
+                completedDelta--;
+            }
+            user->tasks.erase(found);
+            taskOwners.remove(entry.taskId, entry.userId);
+            if (journal) journal->logDeleteTask(entry.userId, entry.taskId);
+        }
+        else
+        {
+            task.status = "Completed";
+            entry.completed = true;
+            shard.dueIndex.insert(entry);
+            user->dueIndex.insert(entry);
+            user->completedCount++;
+            completedDelta++;
+            if (journal) journal->logCompleteTask(entry.userId, entry.taskId);
+        }
+        markViewDirty(user);
+        changed++;
+    }
+
+    if (remove) totalTasksCount -= static_cast<int>(changed);
+    completedTasksCount += completedDelta;
+    return changed;
+}
+
+// Walk the status blocks and date range of index (a user's or the shard's due
+// index) once, completing or removing each selected task as it is met: the walked
+// index is edited through the iterator, the other index by key. The shared
+// counters change once for the whole batch. ids is sorted; caller holds the shard lock.
+size_t UserManager::applyTaskBatch(UserShard& shard, DueIndex& index, const TaskFilter& filter,
+                                   const vector<int>& ids, bool remove)
+{
+    if (filter.dueFrom > filter.dueTo) return 0;
+
+    bool walkingShard = &index == &shard.dueIndex;
+    User* user = nullptr;
+    size_t changed = 0;
+    int completedDelta = 0;
+
+    for (bool completed : { false, true })
+    {
+        // Completing only looks at the ongoing block
+        if (completed && (!remove || filter.status == TaskFilter::Status::Ongoing)) continue;
+        if (!completed && filter.status == TaskFilter::Status::Completed) continue;
+
+        // Bounded by key, not by an end iterator: completed entries inserted
+        // during the walk may land right after the range
+        const DueEntry last = { completed, filter.dueTo, INT_MAX, 0 };
+        auto it = index.lower_bound({ completed, filter.dueFrom, INT_MIN, 0 });
+        auto doneHint = index.end();
+        while (it != index.end() && !(last < *it))
+        {
+            if (!ids.empty() && !binary_search(ids.begin(), ids.end(), it->taskId))
+            {
+                ++it;
+                continue;
+            }
+
+            DueEntry entry = *it;
+            if (!user || user->id != entry.userId) user = findUserById(entry.userId);
+            DueIndex& other = walkingShard ? user->dueIndex : shard.dueIndex;
+            it = index.erase(it);
+            other.erase(entry);
+            if (reminders) reminders->cancel(entry.taskId);
+
+            if (remove)
+            {
+                if (entry.completed)
+                {
+                    user->completedCount--;
+                    completedDelta--;
+                }
+                user->tasks.erase(entry.taskId);
+                taskOwners.remove(entry.taskId, entry.userId);
+                if (journal) journal->logDeleteTask(entry.userId, entry.taskId);
+            }
+            else
+            {
+                user->tasks.find(entry.taskId)->second.status = "Completed";
+                entry.completed = true;
+                // Entries come in date order - the last insert is usually the right hint
+                doneHint = next(index.insert(doneHint, entry));
+                other.insert(entry);
+                user->completedCount++;
+                completedDelta++;
+                if (journal) journal->logCompleteTask(entry.userId, entry.taskId);
+            }
+            markViewDirty(user);
+            changed++;
+        }
+    }
+
+    if (remove) totalTasksCount -= static_cast<int>(changed);
+    completedTasksCount += completedDelta;
+    return changed;
+}
@@ -0,0 +1,75 @@
+#include <cstdio>
+#include <ctime>
+#include "dateutil.h"
+
+uint32_t packDate(const string& date)
+{
+    if (date.length() != 10 || date[2] != '/' || date[5] != '/') return 0;
+    uint32_t day = 0, month = 0, year = 0;
+    for (int i = 0; i < 10; i++)
+    {
+        if (i == 2 || i == 5) continue;
+        if (date[i] < '0' || date[i] > '9') return 0;
+        uint32_t digit = date[i] - '0';
+        if (i < 2) day = day * 10 + digit;
+        else if (i < 5) month = month * 10 + digit;
+        else year = year * 10 + digit;
+    }
+    return year * 10000 + month * 100 + day;
+}
+
+string unpackDate(uint32_t packed)
+{
+    if (packed == 0) return "--/--/----";
+    char text[11];
+    snprintf(text, sizeof(text), "%02u/%02u/%04u",
+             static_cast<unsigned>(packed % 100),
+             static_cast<unsigned>(packed / 100 % 100),
+             static_cast<unsigned>(packed / 10000 % 10000));
+    return text;
+}
+
+uint32_t todayPacked()
+{
+    return packedDateAfterDays(0);
+}
+
+uint32_t packedDateAfterDays(int days)
+{
+    time_t now = time(nullptr);
+    tm local = *localtime(&now);
+    local.tm_mday += days;
+    local.tm_hour = 12; // Stay clear of DST edges while normalising
+    mktime(&local);
+    return static_cast<uint32_t>((local.tm_year + 1900) * 10000 + (local.tm_mon + 1) * 100 + local.tm_mday);
+}
+
+// Proleptic Gregorian calendar in 400-year eras (H. Hinnant's days_from_civil)
+int32_t dayNumber(uint32_t packed)
+{
+    int32_t year = static_cast<int32_t>(packed / 10000);
+    int32_t month = static_cast<int32_t>(packed / 100 % 100);
+    int32_t day = static_cast<int32_t>(packed % 100);
+    month = month < 1 ? 1 : (month > 12 ? 12 : month);
+    if (month <= 2) year--;
+    int32_t era = (year >= 0 ? year : year - 399) / 400;
+    int32_t yearOfEra = year - era * 400;
+    int32_t dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    int32_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+uint32_t packedDateOfDay(int32_t days)
+{
+    int32_t z = days + 719468;
+    int32_t era = (z >= 0 ? z : z - 146096) / 146097;
+    int32_t dayOfEra = z - era * 146097;
+    int32_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    int32_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    int32_t monthIndex = (5 * dayOfYear + 2) / 153;
+    int32_t day = dayOfYear - (153 * monthIndex + 2) / 5 + 1;
+    int32_t month = monthIndex + (monthIndex < 10 ? 3 : -9);
+    int32_t year = yearOfEra + era * 400 + (month <= 2 ? 1 : 0);
+    if (year < 0) return 0;
+    return static_cast<uint32_t>(year * 10000 + month * 100 + day);
+}
@@ -0,0 +1,20 @@
+#ifndef DATE_UTIL_H
+#define DATE_UTIL_H
+
+#include <cstdint>
+#include <string>
+using namespace std;
+
+// Compact dates: DD/MM/YYYY packed as the integer YYYYMMDD, so numeric order is date order.
+// 0 means "no date" (the text was not a DD/MM/YYYY date).
+
+uint32_t packDate(const string& date);        // DD/MM/YYYY -> YYYYMMDD, 0 if not a date
+string unpackDate(uint32_t packed);           // YYYYMMDD -> DD/MM/YYYY, "--/--/----" for 0
+uint32_t todayPacked();                       // Local date today
+uint32_t packedDateAfterDays(int days);       // Local date today + days
+
+// Day numbers count days from 01/01/1970 (negative before), so date arithmetic is integer arithmetic
+int32_t dayNumber(uint32_t packed);           // YYYYMMDD -> day number; day 31 of a 30-day month is the 1st of the next
+uint32_t packedDateOfDay(int32_t days);       // Day number -> YYYYMMDD
+
+#endif
@@ -0,0 +1,105 @@
+#include <functional>
+#include "identityindex.h"
+
+uint32_t IdentityIndex::hashOf(string_view key)
+{
+    size_t h = hash<string_view>()(key);
+    return static_cast<uint32_t>(h ^ (h >> 32));
+}
+
+int IdentityIndex::FlatTable::find(string_view key, uint32_t hash) const
+{
+    if (slots.empty()) return 0;
+
+    for (size_t i = hash & mask(); slots[i].key.data(); i = (i + 1) & mask())
+    {
+        if (slots[i].hash == hash && slots[i].key == key) return slots[i].userId;
+    }
+    return 0;
+}
+
+void IdentityIndex::FlatTable::insert(string_view key, uint32_t hash, int userId)
+{
+    if ((used + 1) * 4 > slots.size() * 3) grow(used + 1);
+
+    size_t i = hash & mask();
+    while (slots[i].key.data())
+    {
+        if (slots[i].hash == hash && slots[i].key == key)
+        {
+            slots[i] = { key, hash, userId };   // Re-point an existing name
+            return;
+        }
+        i = (i + 1) & mask();
+    }
+    slots[i] = { key, hash, userId };
+    used++;
+}
+
+void IdentityIndex::FlatTable::erase(string_view key, uint32_t hash, int userId)
+{
+    if (slots.empty()) return;
+
+    size_t i = hash & mask();
+    while (slots[i].key.data())
+    {
+        if (slots[i].hash == hash && slots[i].userId == userId && slots[i].key == key) break;
+        i = (i + 1) & mask();
+    }
+    if (!slots[i].key.data()) return;
+
+    // Backward shift: pull later entries of the probe run into the hole
+    for (size_t j = (i + 1) & mask(); slots[j].key.data(); j = (j + 1) & mask())
+    {
+        size_t home = slots[j].hash & mask();
+        if (((j - home) & mask()) >= ((j - i) & mask()))
+        {
+            slots[i] = slots[j];
+            i = j;
+        }
+    }
+    slots[i] = Slot();
+    used--;
+}
+
+void IdentityIndex::FlatTable::reserve(size_t count)
+{
+    if (count * 4 > slots.size() * 3) grow(count);
+}
+
+// Rehash into a table holding minimumCapacity at 3/4 load - the cached hashes
+// mean the user strings are not read
+void IdentityIndex::FlatTable::grow(size_t minimumCapacity)
+{
+    size_t capacity = 16;
+    while (minimumCapacity * 4 > capacity * 3) capacity *= 2;
+    if (capacity <= slots.size()) capacity = slots.size() * 2;
+
+    vector<Slot> old(capacity);
+    old.swap(slots);
+    for (const Slot& slot : old)
+    {
+        if (!slot.key.data()) continue;
+        size_t i = slot.hash & mask();
+        while (slots[i].key.data()) i = (i + 1) & mask();
+        slots[i] = slot;
+    }
+}
+
+void IdentityIndex::add(int userId, string_view username, string_view email)
+{
+    byUsername.insert(username, hashOf(username), userId);
+    byEmail.insert(email, hashOf(email), userId);
+}
+
+void IdentityIndex::remove(int userId, string_view username, string_view email)
+{
+    byUsername.erase(username, hashOf(username), userId);
+    byEmail.erase(email, hashOf(email), userId);
+}
+
+void IdentityIndex::reserve(size_t count)
+{
+    byUsername.reserve(count);
+    byEmail.reserve(count);
+}
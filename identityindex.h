@@ -0,0 +1,62 @@
+#ifndef IDENTITY_INDEX_H
+#define IDENTITY_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+using namespace std;
+
+// Username -> user ID and email -> user ID in two flat open-addressing tables.
+// The keys are string_views into the User record's own username and email, so
+// each name is stored once (in the User) and a lookup takes any string_view
+// without building a string. Linear probing with the hash cached in the slot;
+// removal shifts the following entries back, so there are no tombstones.
+//
+// The viewed strings must stay put while indexed: remove a user before
+// changing or destroying its username or email, and add it again afterwards.
+class IdentityIndex {
+private:
+    struct Slot {
+        string_view key;     // Empty data() = free slot
+        uint32_t hash;
+        int userId;
+    };
+
+    class FlatTable {
+    private:
+        vector<Slot> slots;  // Power of two, at most 3/4 full
+        size_t used = 0;
+
+        size_t mask() const { return slots.size() - 1; }
+        void grow(size_t minimumCapacity);
+
+    public:
+        int find(string_view key, uint32_t hash) const;
+        void insert(string_view key, uint32_t hash, int userId);
+        void erase(string_view key, uint32_t hash, int userId);
+        void reserve(size_t count);
+        size_t size() const { return used; }
+        size_t capacity() const { return slots.size(); }
+    };
+
+    FlatTable byUsername;
+    FlatTable byEmail;
+
+    static uint32_t hashOf(string_view key);
+
+public:
+    // 0 when nobody has that name (user IDs start at 101)
+    int findUsername(string_view username) const { return byUsername.find(username, hashOf(username)); }
+    int findEmail(string_view email) const { return byEmail.find(email, hashOf(email)); }
+
+    // username and email must view the User's strings - see the class comment
+    void add(int userId, string_view username, string_view email);
+    void remove(int userId, string_view username, string_view email);
+    void reserve(size_t count);
+
+    size_t size() const { return byUsername.size(); }
+    size_t memoryBytes() const { return (byUsername.capacity() + byEmail.capacity()) * sizeof(Slot); }
+};
+
+#endif
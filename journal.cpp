@@ -0,0 +1,468 @@
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include "journal.h"
+
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+const char JOURNAL_MAGIC[4] = { 'M', 'U', 'T', 'J' };
+const uint32_t JOURNAL_VERSION = 1;
+const size_t JOURNAL_HEADER_SIZE = 8;
+
+#ifdef _WIN32
+int fileOpen(const string& name) { return _open(name.c_str(), _O_RDWR | _O_CREAT | _O_APPEND | _O_BINARY, _S_IREAD | _S_IWRITE); }
+int fileWrite(int fd, const char* data, size_t size) { return _write(fd, data, static_cast<unsigned>(size)); }
+int fileSync(int fd) { return _commit(fd); }
+int fileTruncate(int fd, long long size) { return _chsize_s(fd, size); }
+int fileClose(int fd) { return _close(fd); }
+#else
+int fileOpen(const string& name) { return ::open(name.c_str(), O_RDWR | O_CREAT | O_APPEND, 0644); }
+int fileWrite(int fd, const char* data, size_t size) { return static_cast<int>(::write(fd, data, size)); }
+int fileSync(int fd) { return ::fsync(fd); }
+int fileTruncate(int fd, long long size) { return ::ftruncate(fd, size); }
+int fileClose(int fd) { return ::close(fd); }
+#endif
+
+uint32_t fnv1a(const char* data, size_t size)
+{
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; i++)
+    {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// Fields carried by each record type
+struct RecordShape
+{
+    bool hasTask;
+    bool hasFlag;
+    int strings;
+};
+
+bool shapeOf(JournalOp op, RecordShape& shape)
+{
+    switch (op)
+    {
+    case JournalOp::AddUser:         shape = { false, false, 3 }; return true;
+    case JournalOp::AddTask:         shape = { true,  false, 2 }; return true;
+    case JournalOp::EditTaskTitle:
+    case JournalOp::EditTaskDueDate:
+    case JournalOp::SetTaskStatus:   shape = { true,  false, 1 }; return true;
+    case JournalOp::CompleteTask:
+    case JournalOp::DeleteTask:      shape = { true,  false, 0 }; return true;
+    case JournalOp::SetUserActive:   shape = { false, true,  0 }; return true;
+    case JournalOp::DeleteUser:      shape = { false, false, 0 }; return true;
+    case JournalOp::ChangeUsername:
+    case JournalOp::ChangeEmail:
+    case JournalOp::ChangePassword:  shape = { false, false, 1 }; return true;
+    }
+    return false;
+}
+
+void putRaw(string& out, const void* data, size_t size)
+{
+    out.append(static_cast<const char*>(data), size);
+}
+
+// Encode a full record: length, op, payload, checksum
+string encode(const JournalRecord& rec)
+{
+    RecordShape shape;
+    shapeOf(rec.op, shape);
+
+    string body;
+    body.push_back(static_cast<char>(rec.op));
+    int32_t userId = rec.userId;
+    putRaw(body, &userId, sizeof(userId));
+    if (shape.hasTask)
+    {
+        int32_t taskId = rec.taskId;
+        putRaw(body, &taskId, sizeof(taskId));
+    }
+    if (shape.hasFlag)
+    {
+        body.push_back(static_cast<char>(rec.flag));
+    }
+    const string* texts[3] = { &rec.text1, &rec.text2, &rec.text3 };
+    for (int i = 0; i < shape.strings; i++)
+    {
+        uint16_t len = static_cast<uint16_t>(min<size_t>(texts[i]->size(), UINT16_MAX));
+        putRaw(body, &len, sizeof(len));
+        body.append(*texts[i], 0, len);
+    }
+
+    string record;
+    uint32_t payloadLength = static_cast<uint32_t>(body.size() - 1);
+    uint32_t checksum = fnv1a(body.data(), body.size());
+    putRaw(record, &payloadLength, sizeof(payloadLength));
+    record += body;
+    putRaw(record, &checksum, sizeof(checksum));
+    return record;
+}
+
+// Decode the record at data[pos]; returns its size, 0 if torn or corrupt
+size_t decode(const char* data, size_t size, size_t pos, JournalRecord& rec)
+{
+    uint32_t payloadLength;
+    if (size - pos < sizeof(payloadLength) + 1) return 0;
+    memcpy(&payloadLength, data + pos, sizeof(payloadLength));
+
+    size_t total = sizeof(payloadLength) + 1 + payloadLength + sizeof(uint32_t);
+    if (size - pos < total) return 0;
+
+    const char* body = data + pos + sizeof(payloadLength);
+    uint32_t checksum;
+    memcpy(&checksum, body + 1 + payloadLength, sizeof(checksum));
+    if (checksum != fnv1a(body, 1 + payloadLength)) return 0;
+
+    RecordShape shape;
+    rec = JournalRecord();
+    rec.op = static_cast<JournalOp>(body[0]);
+    if (!shapeOf(rec.op, shape)) return 0;
+
+    const char* p = body + 1;
+    const char* end = p + payloadLength;
+    auto take = [&](void* out, size_t n) {
+        if (static_cast<size_t>(end - p) < n) return false;
+        memcpy(out, p, n);
+        p += n;
+        return true;
+    };
+
+    int32_t value;
+    if (!take(&value, sizeof(value))) return 0;
+    rec.userId = value;
+    if (shape.hasTask)
+    {
+        if (!take(&value, sizeof(value))) return 0;
+        rec.taskId = value;
+    }
+    if (shape.hasFlag)
+    {
+        uint8_t flag;
+        if (!take(&flag, sizeof(flag))) return 0;
+        rec.flag = flag;
+    }
+    string* texts[3] = { &rec.text1, &rec.text2, &rec.text3 };
+    for (int i = 0; i < shape.strings; i++)
+    {
+        uint16_t len;
+        if (!take(&len, sizeof(len)) || static_cast<size_t>(end - p) < len) return 0;
+        texts[i]->assign(p, len);
+        p += len;
+    }
+    return total;
+}
+
+// Read a whole journal file; returns false if missing or not a journal
+bool readJournalFile(const string& filename, string& contents)
+{
+    ifstream file(filename, ios::binary);
+    if (!file.is_open()) return false;
+    contents.assign(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+    return contents.size() >= JOURNAL_HEADER_SIZE && memcmp(contents.data(), JOURNAL_MAGIC, 4) == 0;
+}
+
+// Length of the intact record prefix, calling apply for each record when given
+size_t scanRecords(const string& contents, const function<void(const JournalRecord&)>* apply)
+{
+    size_t pos = JOURNAL_HEADER_SIZE;
+    JournalRecord rec;
+    while (pos < contents.size())
+    {
+        size_t used = decode(contents.data(), contents.size(), pos, rec);
+        if (used == 0) break; // Torn write at the tail - everything after it is lost
+        if (apply) (*apply)(rec);
+        pos += used;
+    }
+    return pos;
+}
+}
+
+Journal::Journal()
+    : fd(-1), pendingRecords(0), groupRecords(64), groupDelayMs(20), stopping(false)
+{
+}
+
+Journal::~Journal()
+{
+    close();
+}
+
+bool Journal::open(const string& filename, size_t groupCommitRecords, int groupCommitDelayMs)
+{
+    close();
+
+    // Cut off a torn tail so new records stay readable
+    string contents;
+    bool exists = readJournalFile(filename, contents);
+    if (!exists && contents.size() >= JOURNAL_HEADER_SIZE)
+    {
+        cerr << "Error: " << filename << " is not a journal file" << endl;
+        return false;
+    }
+
+    fd = fileOpen(filename);
+    if (fd < 0)
+    {
+        cerr << "Error: Could not open journal file " << filename << endl;
+        return false;
+    }
+
+    if (!exists)
+    {
+        char header[JOURNAL_HEADER_SIZE];
+        memcpy(header, JOURNAL_MAGIC, 4);
+        memcpy(header + 4, &JOURNAL_VERSION, 4);
+        fileTruncate(fd, 0);
+        fileWrite(fd, header, sizeof(header));
+        fileSync(fd);
+    }
+    else
+    {
+        size_t valid = scanRecords(contents, nullptr);
+        if (valid < contents.size())
+        {
+            fileTruncate(fd, static_cast<long long>(valid));
+            fileSync(fd);
+        }
+    }
+
+    path = filename;
+    groupRecords = groupCommitRecords > 0 ? groupCommitRecords : 1;
+    groupDelayMs = groupCommitDelayMs;
+    stopping = false;
+    flusher = thread(&Journal::flusherLoop, this);
+    return true;
+}
+
+void Journal::close()
+{
+    if (fd < 0) return;
+
+    {
+        lock_guard<mutex> guard(lock);
+        stopping = true;
+        commitLocked();
+    }
+    wake.notify_all();
+    if (flusher.joinable()) flusher.join();
+
+    fileClose(fd);
+    fd = -1;
+}
+
+// Background commit so a lone record is durable within groupDelayMs
+void Journal::flusherLoop()
+{
+    unique_lock<mutex> guard(lock);
+    while (!stopping)
+    {
+        wake.wait(guard, [this] { return stopping || pendingRecords > 0; });
+        if (stopping) break;
+
+        wake.wait_for(guard, chrono::milliseconds(groupDelayMs), [this] { return stopping; });
+        commitLocked();
+    }
+}
+
+bool Journal::commitLocked()
+{
+    if (buffer.empty()) return true;
+
+    bool ok = true;
+    size_t written = 0;
+    while (written < buffer.size())
+    {
+        int n = fileWrite(fd, buffer.data() + written, buffer.size() - written);
+        if (n <= 0)
+        {
+            ok = false;
+            break;
+        }
+        written += n;
+    }
+    if (ok && fileSync(fd) != 0) ok = false;
+    if (!ok)
+    {
+        cerr << "Error: Could not write journal file " << path << endl;
+    }
+
+    buffer.clear();
+    pendingRecords = 0;
+    return ok;
+}
+
+void Journal::append(const string& record)
+{
+    if (fd < 0) return;
+
+    lock_guard<mutex> guard(lock);
+    buffer += record;
+    pendingRecords++;
+    if (static_cast<size_t>(pendingRecords) >= groupRecords)
+    {
+        commitLocked();
+    }
+    else if (pendingRecords == 1)
+    {
+        wake.notify_one();
+    }
+}
+
+bool Journal::flush()
+{
+    if (fd < 0) return false;
+    lock_guard<mutex> guard(lock);
+    return commitLocked();
+}
+
+bool Journal::truncate()
+{
+    if (fd < 0) return false;
+
+    lock_guard<mutex> guard(lock);
+    buffer.clear();
+    pendingRecords = 0;
+    if (fileTruncate(fd, JOURNAL_HEADER_SIZE) != 0) return false;
+    return fileSync(fd) == 0;
+}
+
+bool Journal::replay(const string& filename, const function<void(const JournalRecord&)>& apply)
+{
+    string contents;
+    if (!readJournalFile(filename, contents))
+    {
+        return contents.size() < JOURNAL_HEADER_SIZE; // A missing journal just means nothing to replay
+    }
+    scanRecords(contents, &apply);
+    return true;
+}
+
+void Journal::logAddUser(int userId, const string& username, const string& email, const string& password)
+{
+    JournalRecord rec;
+    rec.op = JournalOp::AddUser;
+    rec.userId = userId;
+    rec.text1 = username;
+    rec.text2 = email;
+    rec.text3 = password;
+    append(encode(rec));
+}
+
+void Journal::logAddTask(int userId, int taskId, const string& title, const string& dueDate)
+{
+    JournalRecord rec;
+    rec.op = JournalOp::AddTask;
+    rec.userId = userId;
+    rec.taskId = taskId;
+    rec.text1 = title;
+    rec.text2 = dueDate;
+    append(encode(rec));
+}
+
+void Journal::logEditTaskTitle(int userId, int taskId, const string& title)
+{
+    JournalRecord rec;
+    rec.op = JournalOp::EditTaskTitle;
+    rec.userId = userId;
+    rec.taskId = taskId;
+    rec.text1 = title;
+    append(encode(rec));
+}
+
+void Journal::logEditTaskDueDate(int userId, int taskId, const string& dueDate)
+{
+    JournalRecord rec;
+    rec.op = JournalOp::EditTaskDueDate;
+    rec.userId = userId;
+    rec.taskId = taskId;
+    rec.text1 = dueDate;
+    append(encode(rec));
+}
+
+void Journal::logSetTaskStatus(int userId, int taskId, const string& status)
+{
+    JournalRecord rec;
+    rec.op = JournalOp::SetTaskStatus;
+    rec.userId = userId;
+    rec.taskId = taskId;
+    rec.text1 = status;
+    append(encode(rec));
+}
+
+void Journal::logCompleteTask(int userId, int taskId)
+{
+    JournalRecord rec;
+    rec.op = JournalOp::CompleteTask;
+    rec.userId = userId;
+    rec.taskId = taskId;
+    append(encode(rec));
+}
+
+void Journal::logDeleteTask(int userId, int taskId)
+{
+    JournalRecord rec;
+    rec.op = JournalOp::DeleteTask;
+    rec.userId = userId;
+    rec.taskId = taskId;
+    append(encode(rec));
+}
+
+void Journal::logSetUserActive(int userId, bool active)
+{
+    JournalRecord rec;
+    rec.op = JournalOp::SetUserActive;
+    rec.userId = userId;
+    rec.flag = active ? 1 : 0;
+    append(encode(rec));
+}
+
+void Journal::logDeleteUser(int userId)
+{
+    JournalRecord rec;
+    rec.op = JournalOp::DeleteUser;
+    rec.userId = userId;
+    append(encode(rec));
+}
+
+void Journal::logChangeUsername(int userId, const string& username)
+{
+    JournalRecord rec;
+    rec.op = JournalOp::ChangeUsername;
+    rec.userId = userId;
+    rec.text1 = username;
+    append(encode(rec));
+}
+
+void Journal::logChangeEmail(int userId, const string& email)
+{
+    JournalRecord rec;
+    rec.op = JournalOp::ChangeEmail;
+    rec.userId = userId;
+    rec.text1 = email;
+    append(encode(rec));
+}
+
+void Journal::logChangePassword(int userId, const string& password)
+{
+    JournalRecord rec;
+    rec.op = JournalOp::ChangePassword;
+    rec.userId = userId;
+    rec.text1 = password;
+    append(encode(rec));
+}
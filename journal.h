@@ -0,0 +1,101 @@
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+using namespace std;
+
+// Mutation types recorded in the journal. Every record carries absolute
+// values (never "toggle"), so replaying a record twice is harmless.
+enum class JournalOp : uint8_t {
+    AddUser = 1,        // userId, username, email, password
+    AddTask,            // userId, taskId, title, dueDate
+    EditTaskTitle,      // userId, taskId, title
+    EditTaskDueDate,    // userId, taskId, dueDate
+    SetTaskStatus,      // userId, taskId, status
+    CompleteTask,       // userId, taskId
+    DeleteTask,         // userId, taskId
+    SetUserActive,      // userId, flag
+    DeleteUser,         // userId
+    ChangeUsername,     // userId, username
+    ChangeEmail,        // userId, email
+    ChangePassword      // userId, password
+};
+
+// One decoded journal record - unused fields stay empty
+struct JournalRecord {
+    JournalOp op = JournalOp::AddUser;
+    int userId = 0;
+    int taskId = 0;
+    int flag = 0;
+    string text1;
+    string text2;
+    string text3;
+};
+
+// Append-only write-ahead journal.
+//
+// File layout: "MUTJ" + u32 version, then records of
+//   u32 payloadLength, u8 op, payload, u32 FNV-1a checksum of op+payload.
+// Appends are buffered and made durable in groups: a commit (write + fsync)
+// happens when groupRecords records are pending, or at the latest
+// groupDelayMs after the first pending record via a background flusher.
+class Journal {
+private:
+    int fd;
+    string path;
+    string buffer;              // Encoded records not yet written
+    int pendingRecords;
+    size_t groupRecords;
+    int groupDelayMs;
+    bool stopping;
+    mutex lock;
+    condition_variable wake;
+    thread flusher;
+
+    void append(const string& record);
+    bool commitLocked();        // Write and fsync the buffer, caller holds lock
+    void flusherLoop();
+
+public:
+    Journal();
+    ~Journal();
+
+    Journal(const Journal&) = delete;
+    Journal& operator=(const Journal&) = delete;
+
+    // Open for appending; a torn record at the end of the file is cut off first
+    bool open(const string& filename, size_t groupCommitRecords = 64, int groupCommitDelayMs = 20);
+    void close();
+    bool isOpen() const { return fd >= 0; }
+
+    // Force every pending record to disk
+    bool flush();
+
+    // Drop all records (after a checkpoint wrote them into the snapshot)
+    bool truncate();
+
+    // Read every intact record of a journal file in order.
+    // Returns false if the file exists but is not a journal.
+    static bool replay(const string& filename, const function<void(const JournalRecord&)>& apply);
+
+    // Typed appends, one per mutation
+    void logAddUser(int userId, const string& username, const string& email, const string& password);
+    void logAddTask(int userId, int taskId, const string& title, const string& dueDate);
+    void logEditTaskTitle(int userId, int taskId, const string& title);
+    void logEditTaskDueDate(int userId, int taskId, const string& dueDate);
+    void logSetTaskStatus(int userId, int taskId, const string& status);
+    void logCompleteTask(int userId, int taskId);
+    void logDeleteTask(int userId, int taskId);
+    void logSetUserActive(int userId, bool active);
+    void logDeleteUser(int userId);
+    void logChangeUsername(int userId, const string& username);
+    void logChangeEmail(int userId, const string& email);
+    void logChangePassword(int userId, const string& password);
+};
+
+#endif
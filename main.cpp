@@ -1,19 +1,38 @@
+#include <cstdlib>
 #include <iostream>
+#include <fstream>
 #include <limits>
+#include <string>
 #include "usermanager.h"
+#include "batchexecutor.h"
+#include "dateutil.h"
+#include "journal.h"
+#include "reminders.h"
+#include "terminal.h"
 using namespace std;
 
-void mainMenu(UserManager &um) {
+// Data files - the binary snapshot is the primary store, the text file is the export format
+const string DATA_TEXT_FILE = "C:\\Users\\HP\\Desktop\\Shakib\\Multi-User-Task-Planner\\data.txt";
+const string DATA_SNAPSHOT_FILE = "C:\\Users\\HP\\Desktop\\Shakib\\Multi-User-Task-Planner\\data.bin";
+const string DATA_JOURNAL_FILE = "C:\\Users\\HP\\Desktop\\Shakib\\Multi-User-Task-Planner\\data.journal";
+const string REMINDER_SPOOL_FILE = "C:\\Users\\HP\\Desktop\\Shakib\\Multi-User-Task-Planner\\reminders.spool";
+const string SLOW_OP_LOG_FILE = "C:\\Users\\HP\\Desktop\\Shakib\\Multi-User-Task-Planner\\slow_ops.log";
+const long long DEFAULT_SLOW_OP_MS = 100; // Operations at least this slow go to the slow-op log
+
+void mainMenu(UserManager &um, Terminal &terminal, ReminderScheduler &reminders) {
     int choice;
 
     // Main Application
     do {
-        cout << "--------- Task Planner Main Menu ---------" << endl;
-        cout << "1. Admin Dashboard" << endl;
-        cout << "2. User Portal" << endl;
-        cout << "3. Help Desk" << endl;
-        cout << "4. Exit" << endl;
-        cout << "Enter your choice: ";
+        reminders.advanceTo(todayPacked()); // Send the reminders that came due since the last screen
+
+        terminal.present("--------- Task Planner Main Menu ---------\n"
+                         "1. Admin Dashboard\n"
+                         "2. User Portal\n"
+                         "3. Help Desk\n"
+                         "4. Export Data (Text)\n"
+                         "5. Exit\n"
+                         "Enter your choice: ");
 
         if (!(cin >> choice)) {
             cout << "Invalid input! Please enter a number." << endl;
@@ -36,7 +55,7 @@ void mainMenu(UserManager &um) {
             }
 
             case 2: {
-                system("cls");
+                terminal.clear();
                 cout << "Welcome to User Portal!" << endl;
                 um.userPortalMenu(); // Display User Portal System
                 break;
@@ -48,7 +67,12 @@ void mainMenu(UserManager &um) {
             }
 
             case 4: {
-                um.saveToFile("C:\\Users\\HP\\Desktop\\Shakib\\Multi-User-Task-Planner\\data.txt");
+                um.saveToFile(DATA_TEXT_FILE); // Human readable export
+                break;
+            }
+
+            case 5: {
+                um.checkpoint(DATA_SNAPSHOT_FILE); // Snapshot now holds everything, journal is emptied
                 cout << "Exiting program.........." << endl;
                 break;
             }
@@ -59,18 +83,96 @@ void mainMenu(UserManager &um) {
             }
         }
 
-        if (choice != 4) {
+        if (choice != 5) {
             cout << "Press Enter to continue......";
             cin.get();
         }
 
-    } while (choice != 4);
+    } while (choice != 5);
+}
+
+// Headless mode: run a command script (or stdin with "-") without any menus
+int runBatch(UserManager &um, const string &source, bool quiet) {
+    BatchExecutor executor(um);
+    BatchSummary summary;
+
+    if (source == "-") {
+        summary = executor.run(cin, cout, !quiet);
+    } else {
+        ifstream script(source);
+        if (!script.is_open()) {
+            cerr << "Error: Could not open batch script " << source << endl;
+            return 1;
+        }
+        summary = executor.run(script, cout, !quiet);
+    }
+
+    cerr << "Batch finished: " << summary.executed << " commands, "
+         << summary.succeeded << " ok, " << summary.failed << " failed, "
+         << summary.parseErrors << " parse errors in " << summary.seconds << "s" << endl;
+    return (summary.failed == 0 && summary.parseErrors == 0) ? 0 : 2;
+}
+
+// Slow-op threshold in milliseconds: --slow-op-ms <n> anywhere on the command line, 0 turns the log off
+long long slowOpMs(int argc, char *argv[]) {
+    for (int i = 1; i + 1 < argc; i++) {
+        if (string(argv[i]) == "--slow-op-ms") return atoll(argv[i + 1]);
+    }
+    return DEFAULT_SLOW_OP_MS;
 }
 
 // Main Function Of Multi-User Task Planner application
-int main() {
+// Usage: Task_Planner                      (interactive menus)
+//        Task_Planner --batch <file|-> [--quiet]
+//        either form can add --slow-op-ms <n>
+int main(int argc, char *argv[]) {
+#ifndef TASK_PLANNER_NO_METRICS
+    ofstream slowOpLog; // Declared first so it outlives the UserManager writing to it
+#endif
     UserManager userManager; // Initialize UserManager object
-    userManager.loadFromFile("C:\\Users\\HP\\Desktop\\Shakib\\Multi-User-Task-Planner\\data.txt"); // Load data at start
-    mainMenu(userManager); // Start the main application interface
+
+#ifndef TASK_PLANNER_NO_METRICS
+    long long thresholdMs = slowOpMs(argc, argv);
+    userManager.metrics().setSlowOpThreshold(chrono::milliseconds(thresholdMs));
+    if (thresholdMs > 0) {
+        slowOpLog.open(SLOW_OP_LOG_FILE, ios::app);
+        if (slowOpLog.is_open()) userManager.metrics().setSlowOpLog(&slowOpLog);
+    }
+#endif
+
+    if (argc >= 3 && string(argv[1]) == "--batch") {
+        bool quiet = (argc >= 4 && string(argv[3]) == "--quiet");
+        return runBatch(userManager, argv[2], quiet);
+    }
+
+    // Load data at start - the text file only seeds a first run with no snapshot yet.
+    // A damaged snapshot stops here: mixing in the text file and checkpointing on exit would overwrite it.
+    if (ifstream(DATA_SNAPSHOT_FILE, ios::binary).is_open()) {
+        if (!userManager.loadSnapshot(DATA_SNAPSHOT_FILE)) {
+            cerr << "Error: Could not load " << DATA_SNAPSHOT_FILE
+                 << ". Restore or remove the snapshot file and start again." << endl;
+            return 1;
+        }
+    } else {
+        userManager.loadFromFileParallel(DATA_TEXT_FILE);
+    }
+
+    // Re-apply mutations made after the last snapshot, then journal new ones
+    Journal journal;
+    userManager.replayJournal(DATA_JOURNAL_FILE);
+    if (journal.open(DATA_JOURNAL_FILE)) {
+        userManager.attachJournal(&journal);
+    }
+
+    // Due-soon and overdue reminders are spooled for delivery, fired as the date moves on
+    SpoolReminderSink spool(REMINDER_SPOOL_FILE);
+    ReminderScheduler reminders(todayPacked());
+    if (spool.isOpen()) reminders.attachSink(&spool);
+    userManager.attachReminders(&reminders);
+
+    // Menus draw through the terminal layer: ANSI clear and redraw, one write per screen
+    Terminal terminal;
+    userManager.attachTerminal(&terminal);
+    mainMenu(userManager, terminal, reminders); // Start the main application interface
     return 0;
 }
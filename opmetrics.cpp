@@ -0,0 +1,228 @@
+#include <cstdio>
+#include "opmetrics.h"
+#include "tablerenderer.h"
+
+#ifndef TASK_PLANNER_NO_METRICS
+
+const char* opName(Op op)
+{
+    static const char* const NAMES[OP_COUNT] = {
+        "addUser", "registerUser", "importUsers", "loginUser", "isUsernameUnique",
+        "isEmailUnique", "setUserActive", "changeUsername", "changeEmail", "changePassword",
+        "removeUser", "createTask", "setTaskTitle", "setTaskDueDate", "setTaskStatus",
+        "completeTask", "removeTask", "completeTasks", "removeTasks", "findTask", "findUsersMatching",
+        "findTasksDue", "adminView",
+        "saveToFile", "loadFromFile", "loadFromFileParallel", "saveSnapshot", "loadSnapshot",
+        "replayJournal", "checkpoint"
+    };
+    size_t index = static_cast<size_t>(op);
+    return index < OP_COUNT ? NAMES[index] : "unknown";
+}
+
+// Exact below SUB_BUCKETS; above, the top SUB_BUCKET_BITS + 1 bits pick the bucket
+size_t LatencyHistogram::bucketOf(uint64_t ns)
+{
+    if (ns < SUB_BUCKETS) return static_cast<size_t>(ns);
+
+#if defined(__GNUC__) || defined(__clang__)
+    int exponent = 63 - __builtin_clzll(ns);
+#else
+    int exponent = 0;
+    for (uint64_t rest = ns >> 1; rest; rest >>= 1) exponent++;
+#endif
+    if (exponent > MAX_EXPONENT)
+    {
+        exponent = MAX_EXPONENT;
+        ns = (uint64_t(2) << MAX_EXPONENT) - 1;
+    }
+    int shift = exponent - SUB_BUCKET_BITS;
+    return static_cast<size_t>((shift + 1) * SUB_BUCKETS + ((ns >> shift) - SUB_BUCKETS));
+}
+
+uint64_t LatencyHistogram::upperEdge(size_t bucket)
+{
+    if (bucket < 2 * SUB_BUCKETS) return bucket;
+
+    int shift = static_cast<int>(bucket / SUB_BUCKETS) - 1;
+    uint64_t sub = bucket % SUB_BUCKETS + SUB_BUCKETS;
+    return ((sub + 1) << shift) - 1;
+}
+
+void LatencyHistogram::record(uint64_t ns)
+{
+    buckets[bucketOf(ns)].fetch_add(1, memory_order_relaxed);
+    total.fetch_add(1, memory_order_relaxed);
+    sumNs.fetch_add(ns, memory_order_relaxed);
+
+    uint64_t seen = maxNs.load(memory_order_relaxed);
+    while (ns > seen && !maxNs.compare_exchange_weak(seen, ns, memory_order_relaxed))
+    {
+    }
+}
+
+void LatencyHistogram::reset()
+{
+    for (auto& bucket : buckets)
+    {
+        bucket.store(0, memory_order_relaxed);
+    }
+    total.store(0, memory_order_relaxed);
+    maxNs.store(0, memory_order_relaxed);
+    sumNs.store(0, memory_order_relaxed);
+}
+
+// Walks the buckets - O(BUCKETS), for reports only. Concurrent records may
+// land while walking; the result is then off by those few calls.
+uint64_t LatencyHistogram::percentile(double q) const
+{
+    uint64_t count = total.load(memory_order_relaxed);
+    if (count == 0) return 0;
+
+    uint64_t rank = static_cast<uint64_t>(q * count + 0.5);
+    if (rank < 1) rank = 1;
+    if (rank > count) rank = count;
+
+    uint64_t seen = 0;
+    for (size_t b = 0; b < BUCKETS; b++)
+    {
+        seen += buckets[b].load(memory_order_relaxed);
+        if (seen >= rank) return min(upperEdge(b), max());
+    }
+    return max();
+}
+
+OpMetrics::OpMetrics() : slowThresholdNs(0), slowLog(nullptr)
+{
+}
+
+void OpMetrics::record(Op op, uint64_t ns, uint64_t bytes)
+{
+    OpCounters& counters = ops[static_cast<size_t>(op)];
+    counters.latency.record(ns);
+    if (bytes) counters.bytes.fetch_add(bytes, memory_order_relaxed);
+
+    uint64_t threshold = slowThresholdNs.load(memory_order_relaxed);
+    if (threshold && ns >= threshold) recordSlow(op, ns, bytes);
+}
+
+void OpMetrics::reset()
+{
+    for (OpCounters& counters : ops)
+    {
+        counters.latency.reset();
+        counters.bytes.store(0, memory_order_relaxed);
+    }
+    lock_guard<mutex> guard(slowLock);
+    recentSlow.clear();
+}
+
+void OpMetrics::setSlowOpThreshold(chrono::nanoseconds threshold)
+{
+    slowThresholdNs.store(static_cast<uint64_t>(max<chrono::nanoseconds::rep>(threshold.count(), 0)),
+                          memory_order_relaxed);
+}
+
+void OpMetrics::setSlowOpLog(ostream* log)
+{
+    lock_guard<mutex> guard(slowLock);
+    slowLog = log;
+}
+
+vector<SlowOp> OpMetrics::recentSlowOps() const
+{
+    lock_guard<mutex> guard(slowLock);
+    return vector<SlowOp>(recentSlow.begin(), recentSlow.end());
+}
+
+void OpMetrics::recordSlow(Op op, uint64_t ns, uint64_t bytes)
+{
+    SlowOp slow = { op, ns, bytes, time(nullptr) };
+
+    lock_guard<mutex> guard(slowLock);
+    recentSlow.push_back(slow);
+    if (recentSlow.size() > RECENT_SLOW_OPS) recentSlow.pop_front();
+
+    if (slowLog)
+    {
+        char stamp[32] = "";
+        tm local = {};
+#ifdef _WIN32
+        localtime_s(&local, &slow.when);
+#else
+        localtime_r(&slow.when, &local);
+#endif
+        strftime(stamp, sizeof(stamp), "%Y-%m-%d %H:%M:%S", &local);
+        *slowLog << stamp << " slow " << opName(op) << " " << ns / 1e6 << " ms";
+        if (bytes) *slowLog << " " << bytes << " bytes";
+        *slowLog << '\n';
+        slowLog->flush();
+    }
+}
+
+namespace
+{
+// Microseconds with one decimal, or whole ones once they get long
+string micros(uint64_t ns)
+{
+    char text[32];
+    if (ns < 10000000) snprintf(text, sizeof(text), "%.1f", ns / 1e3);
+    else snprintf(text, sizeof(text), "%.0f", ns / 1e3);
+    return text;
+}
+}
+
+void OpMetrics::writeReport(ostream& out) const
+{
+    TableRenderer table(out, {
+        { "Operation", 22, TableRenderer::Align::Left, false },
+        { "Calls", 11, TableRenderer::Align::Right, false },
+        { "p50 us", 11, TableRenderer::Align::Right, false },
+        { "p99 us", 11, TableRenderer::Align::Right, false },
+        { "Max us", 12, TableRenderer::Align::Right, false },
+        { "MB", 10, TableRenderer::Align::Right, false },
+        { "MB/s", 9, TableRenderer::Align::Right, false }
+    });
+    table.header();
+
+    size_t shown = 0;
+    for (size_t i = 0; i < OP_COUNT; i++)
+    {
+        const LatencyHistogram& histogram = ops[i].latency;
+        if (histogram.count() == 0) continue;
+
+        table.cell(opName(static_cast<Op>(i)))
+             .cell(static_cast<long long>(histogram.count()))
+             .cell(micros(histogram.percentile(0.50)))
+             .cell(micros(histogram.percentile(0.99)))
+             .cell(micros(histogram.max()));
+
+        // Loads and saves also report the bytes they moved
+        uint64_t moved = ops[i].bytes.load(memory_order_relaxed);
+        if (moved)
+        {
+            char mb[32], rate[32];
+            snprintf(mb, sizeof(mb), "%.1f", moved / 1e6);
+            snprintf(rate, sizeof(rate), "%.0f", histogram.sum() ? moved / 1e6 / (histogram.sum() / 1e9) : 0.0);
+            table.cell(mb).cell(rate);
+        }
+        table.endRow();
+        shown++;
+    }
+    if (shown == 0) table.line("No operations recorded yet.");
+
+    vector<SlowOp> slow = recentSlowOps();
+    if (slowThresholdNs.load(memory_order_relaxed))
+    {
+        table.line("");
+        char title[64];
+        snprintf(title, sizeof(title), "Slow operations (>= %g ms), latest last:", slowThresholdNs.load(memory_order_relaxed) / 1e6);
+        table.line(title);
+        for (const SlowOp& op : slow)
+        {
+            table.line("  " + string(opName(op.op)) + " " + micros(op.ns) + " us");
+        }
+        if (slow.empty()) table.line("  none");
+    }
+}
+
+#endif
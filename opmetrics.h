@@ -0,0 +1,176 @@
+#ifndef OP_METRICS_H
+#define OP_METRICS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <vector>
+using namespace std;
+
+// Built-in instrumentation of the UserManager operations: a call counter and a
+// latency histogram per operation, bytes moved by the loads and saves, and a
+// log of operations slower than a threshold. Build with -DTASK_PLANNER_NO_METRICS
+// to compile the timers out of every operation.
+
+#ifndef TASK_PLANNER_NO_METRICS
+
+// Timed operations - the public UserManager operations that do not wait for console
+// input (wrappers such as authenticateUser are counted by the operation they call)
+enum class Op : uint8_t {
+    AddUser,
+    RegisterUser,
+    ImportUsers,
+    LoginUser,
+    IsUsernameUnique,
+    IsEmailUnique,
+    SetUserActive,
+    ChangeUsername,
+    ChangeEmail,
+    ChangePassword,
+    RemoveUser,
+    CreateTask,
+    SetTaskTitle,
+    SetTaskDueDate,
+    SetTaskStatus,
+    CompleteTask,
+    RemoveTask,
+    CompleteTasks,
+    RemoveTasks,
+    FindTask,
+    FindUsersMatching,
+    FindTasksDue,
+    AdminView,
+    SaveToFile,
+    LoadFromFile,
+    LoadFromFileParallel,
+    SaveSnapshot,
+    LoadSnapshot,
+    ReplayJournal,
+    Checkpoint,
+    Count
+};
+
+const size_t OP_COUNT = static_cast<size_t>(Op::Count);
+
+// Display name of an operation (the UserManager method name)
+const char* opName(Op op);
+
+// HDR-style latency histogram in nanoseconds: values below 32 ns are exact,
+// above that every power of two is split into 32 sub-buckets, so a reported
+// percentile is at most ~3% above the true value. Recording is a few relaxed
+// atomic increments - no lock, safe from any thread.
+class LatencyHistogram {
+public:
+    static const int SUB_BUCKET_BITS = 5;
+    static const uint64_t SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static const int MAX_EXPONENT = 40;             // 2^41 ns (~37 minutes) and above share the last bucket
+    static const size_t BUCKETS = (MAX_EXPONENT - SUB_BUCKET_BITS + 2) * SUB_BUCKETS;
+
+    LatencyHistogram() { reset(); }
+
+    void record(uint64_t ns);
+    void reset();
+
+    uint64_t count() const { return total.load(memory_order_relaxed); }
+    uint64_t max() const { return maxNs.load(memory_order_relaxed); }
+    uint64_t sum() const { return sumNs.load(memory_order_relaxed); }
+
+    // Value at quantile q (0..1): the upper edge of the bucket holding it, capped at max()
+    uint64_t percentile(double q) const;
+
+private:
+    array<atomic<uint64_t>, BUCKETS> buckets;
+    atomic<uint64_t> total;
+    atomic<uint64_t> maxNs;
+    atomic<uint64_t> sumNs;
+
+    static size_t bucketOf(uint64_t ns);
+    static uint64_t upperEdge(size_t bucket);
+};
+
+// One operation that took longer than the slow-op threshold
+struct SlowOp {
+    Op op;
+    uint64_t ns;
+    uint64_t bytes;
+    time_t when;
+};
+
+// Per-operation histograms and counters of one UserManager
+class OpMetrics {
+public:
+    static const size_t RECENT_SLOW_OPS = 16;       // Kept for the Performance view
+
+    OpMetrics();
+
+    void record(Op op, uint64_t ns, uint64_t bytes = 0);
+    void reset();
+
+    const LatencyHistogram& latency(Op op) const { return ops[static_cast<size_t>(op)].latency; }
+    uint64_t bytes(Op op) const { return ops[static_cast<size_t>(op)].bytes.load(memory_order_relaxed); }
+
+    // Operations slower than the threshold are kept in a short list and written
+    // to the slow-op log, when one is set. 0 disables the slow-op log.
+    void setSlowOpThreshold(chrono::nanoseconds threshold);
+    chrono::nanoseconds slowOpThreshold() const { return chrono::nanoseconds(slowThresholdNs.load(memory_order_relaxed)); }
+    void setSlowOpLog(ostream* log);
+    vector<SlowOp> recentSlowOps() const;
+
+    // Table of every operation called so far: calls, p50 / p99 / max and bytes
+    void writeReport(ostream& out) const;
+
+private:
+    struct OpCounters {
+        LatencyHistogram latency;
+        atomic<uint64_t> bytes{0};
+    };
+
+    array<OpCounters, OP_COUNT> ops;
+    atomic<uint64_t> slowThresholdNs;
+
+    mutable mutex slowLock;                         // Guards the two below, taken only by slow operations
+    ostream* slowLog;
+    deque<SlowOp> recentSlow;
+
+    void recordSlow(Op op, uint64_t ns, uint64_t bytes);
+};
+
+// Times one operation from construction to destruction
+class OpTimer {
+private:
+    OpMetrics& metrics;
+    Op op;
+    chrono::steady_clock::time_point start;
+    uint64_t bytes;
+
+public:
+    OpTimer(OpMetrics& m, Op o) : metrics(m), op(o), start(chrono::steady_clock::now()), bytes(0) {}
+    ~OpTimer()
+    {
+        auto elapsed = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start);
+        metrics.record(op, static_cast<uint64_t>(elapsed.count()), bytes);
+    }
+    OpTimer(const OpTimer&) = delete;
+    OpTimer& operator=(const OpTimer&) = delete;
+
+    void addBytes(uint64_t count) { bytes += count; }
+};
+
+// Used inside UserManager members: OP_TIMER opens the timer of the enclosing
+// operation, OP_BYTES adds to the bytes it reports. Both vanish in a no-metrics build.
+#define OP_TIMER(op) OpTimer opTimer(opMetrics, op)
+#define OP_BYTES(count) opTimer.addBytes(count)
+
+#else // TASK_PLANNER_NO_METRICS
+
+#define OP_TIMER(op) ((void)0)
+#define OP_BYTES(count) ((void)0)
+
+#endif // TASK_PLANNER_NO_METRICS
+
+#endif
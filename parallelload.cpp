@@ -0,0 +1,258 @@
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include "dateutil.h"
+#include "snapshot.h"
+#include "usermanager.h"
+
+namespace
+{
+const char USER_MARKER[] = "\nUser -->";
+const size_t USER_MARKER_LEN = sizeof(USER_MARKER) - 1;
+
+// Users and highest task ID parsed from one chunk of the text file
+struct ChunkResult
+{
+    vector<User> users;
+    int maxTaskId = 0;
+};
+
+// Minimal tokenizer over a single line - replaces the per-line stringstream
+class LineScanner
+{
+private:
+    const char* pos;
+    const char* end;
+
+public:
+    LineScanner(const char* begin, const char* finish) : pos(begin), end(finish) {}
+
+    bool next(const char*& tokBegin, size_t& tokLen)
+    {
+        while (pos < end && (*pos == ' ' || *pos == '\t' || *pos == '\r')) pos++;
+        if (pos >= end) return false;
+        tokBegin = pos;
+        while (pos < end && *pos != ' ' && *pos != '\t' && *pos != '\r') pos++;
+        tokLen = pos - tokBegin;
+        return true;
+    }
+
+    bool nextString(string& out)
+    {
+        const char* tok;
+        size_t len;
+        if (!next(tok, len)) return false;
+        out.assign(tok, len);
+        return true;
+    }
+
+    bool nextInt(int& out)
+    {
+        const char* tok;
+        size_t len;
+        if (!next(tok, len)) return false;
+
+        size_t i = 0;
+        bool negative = (tok[0] == '-');
+        if (negative || tok[0] == '+') i++;
+
+        size_t digits = 0;
+        long long value = 0;
+        for (; i < len && tok[i] >= '0' && tok[i] <= '9'; i++, digits++)
+        {
+            value = value * 10 + (tok[i] - '0');
+            if (value > 2147483647LL) return false;
+        }
+        if (digits == 0) return false;
+        out = static_cast<int>(negative ? -value : value);
+        return true;
+    }
+};
+
+// Portable memmem - first occurrence of needle in [begin, end) or nullptr
+const char* findBytes(const char* begin, const char* end, const char* needle, size_t needleLen)
+{
+    const char* hit = search(begin, end, needle, needle + needleLen);
+    return hit == end ? nullptr : hit;
+}
+
+// Parse the lines of [begin, end) with the same rules as loadFromFile.
+// A chunk always starts at a "User -->" line so no state crosses chunks.
+void parseChunk(const char* begin, const char* end, ChunkResult& result)
+{
+    User* currentUser = nullptr;
+    const char* line = begin;
+
+    while (line < end)
+    {
+        const char* lineEnd = static_cast<const char*>(memchr(line, '\n', end - line));
+        if (!lineEnd) lineEnd = end;
+
+        LineScanner scan(line, lineEnd);
+        const char* tok;
+        size_t len;
+
+        if (scan.next(tok, len))
+        {
+            if (len == 4 && memcmp(tok, "User", 4) == 0)
+            {
+                string arrow, username, email, password, statusStr;
+                int id = 0;
+                scan.nextString(arrow);
+                bool ok = scan.nextInt(id);
+                scan.nextString(username);
+                scan.nextString(email);
+                scan.nextString(password);
+                scan.nextString(statusStr);
+
+                // Skip invalid entries - check for valid ID and non-empty username
+                if (!ok || id <= 0 || username.empty() || email.empty())
+                {
+                    currentUser = nullptr;
+                }
+                else
+                {
+                    result.users.emplace_back(id, username, email, password, statusStr == "Active");
+                    currentUser = &result.users.back();
+                }
+            }
+            else if (len == 4 && memcmp(tok, "TASK", 4) == 0 && currentUser)
+            {
+                int taskId = 0;
+                string title, dueDate, status;
+                if (!scan.nextInt(taskId) || taskId <= 0)
+                {
+                    line = lineEnd + 1; // Malformed task ID - skip the line
+                    continue;
+                }
+                scan.nextString(title);
+                scan.nextString(dueDate);
+                scan.nextString(status);
+
+                // Replace underscores back with spaces
+                replace(title.begin(), title.end(), '_', ' ');
+                Task& task = currentUser->tasks[taskId];
+                if (task.status == "Completed") currentUser->completedCount--; // Duplicate task ID
+                task = Task(taskId, title, packDate(dueDate), status);
+                if (task.status == "Completed") currentUser->completedCount++;
+                result.maxTaskId = max(result.maxTaskId, taskId);
+            }
+        }
+
+        line = lineEnd + 1;
+    }
+}
+
+// Read N from the "=====>>> Total Users: N!" footer, 0 if absent
+size_t readUserCountFooter(const char* data, size_t size, const char* bodyBegin, const char*& bodyEnd)
+{
+    const char label[] = "Total Users:";
+    size_t tail = min<size_t>(size, 256);
+    const char* from = data + size - tail;
+    const char* hit = nullptr;
+    for (const char* p = from; p + sizeof(label) - 1 <= data + size; p++)
+    {
+        if (memcmp(p, label, sizeof(label) - 1) == 0) hit = p;
+    }
+    if (!hit || hit < bodyBegin) return 0;
+
+    // Body ends at the start of the footer line
+    bodyEnd = hit;
+    while (bodyEnd > bodyBegin && bodyEnd[-1] != '\n') bodyEnd--;
+    return strtoul(hit + sizeof(label) - 1, nullptr, 10);
+}
+}
+
+// Load the text format on several threads: split at "User -->" lines, parse
+// chunks in parallel into partial user lists, then merge into the indexes in one pass
+bool UserManager::loadFromFileParallel(const string& filename, unsigned threadCount)
+{
+    OP_TIMER(Op::LoadFromFileParallel);
+    MappedFile file;
+    if (!file.open(filename))
+    {
+        cerr << "Error: Could not open data file " << filename << endl;
+        return false;
+    }
+
+    const char* data = file.data();
+    const size_t size = file.size();
+    const char* dataEnd = data + size;
+    OP_BYTES(size);
+
+    // Skip the decorated header and the column header line
+    const char* body = data;
+    const char* header = findBytes(data, dataEnd, "*** Users Data ***", 18);
+    if (header)
+    {
+        body = static_cast<const char*>(memchr(header, '\n', dataEnd - header));
+        body = body ? body + 1 : dataEnd;
+        const char* columns = static_cast<const char*>(memchr(body, '\n', dataEnd - body));
+        body = columns ? columns + 1 : dataEnd;
+    }
+
+    const char* bodyEnd = dataEnd;
+    size_t expectedUsers = readUserCountFooter(data, size, body, bodyEnd);
+
+    // Chunk boundaries - a few chunks per thread so uneven users balance out
+    if (threadCount == 0) threadCount = max(1u, thread::hardware_concurrency());
+    size_t chunkCount = threadCount == 1 ? 1 : threadCount * 4;
+    vector<const char*> bounds;
+    bounds.push_back(body);
+    for (size_t i = 1; i < chunkCount; i++)
+    {
+        const char* target = body + (bodyEnd - body) * i / chunkCount;
+        if (target <= bounds.back()) continue;
+        const char* hit = findBytes(target - 1, bodyEnd, USER_MARKER, USER_MARKER_LEN);
+        if (!hit) break;
+        if (hit + 1 > bounds.back()) bounds.push_back(hit + 1);
+    }
+    bounds.push_back(bodyEnd);
+
+    // Parse chunks on a small pool of worker threads
+    size_t chunks = bounds.size() - 1;
+    vector<ChunkResult> results(chunks);
+    atomic<size_t> nextChunk(0);
+    auto worker = [&]() {
+        for (size_t c = nextChunk++; c < chunks; c = nextChunk++)
+        {
+            parseChunk(bounds[c], bounds[c + 1], results[c]);
+        }
+    };
+
+    vector<thread> pool;
+    for (unsigned t = 1; t < min<size_t>(threadCount, chunks); t++)
+    {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto& th : pool)
+    {
+        th.join();
+    }
+
+    // Size every index once, then merge in file order. The footer's count is
+    // only a hint: never more than the users actually parsed
+    size_t parsedUsers = 0;
+    for (const auto& r : results) parsedUsers += r.users.size();
+    reserveUsers(expectedUsers == 0 ? parsedUsers : min(expectedUsers, parsedUsers));
+
+    for (auto& r : results)
+    {
+        for (auto& user : r.users)
+        {
+            restoreUser(move(user));
+        }
+        if (r.maxTaskId >= taskIdCounter)
+        {
+            taskIdCounter = r.maxTaskId + 1;
+        }
+    }
+
+#ifndef NDEBUG
+    statisticsConsistent();
+#endif
+    cout << "Data loaded successfully." << endl;
+    return true;
+}
@@ -0,0 +1,273 @@
+#include <algorithm>
+#include "dateutil.h"
+#include "reminders.h"
+
+void ConsoleReminderSink::deliver(const vector<Reminder>& batch)
+{
+    string text;
+    for (const Reminder& r : batch)
+    {
+        text += r.kind == Reminder::Kind::DueSoon ? "Reminder: task " : "Overdue: task ";
+        text += to_string(r.taskId);
+        text += " of user ";
+        text += to_string(r.userId);
+        text += r.kind == Reminder::Kind::DueSoon ? " is due on " : " was due on ";
+        text += unpackDate(r.dueDate);
+        text += '\n';
+    }
+    out << text << flush;
+}
+
+void SpoolReminderSink::deliver(const vector<Reminder>& batch)
+{
+    string text;
+    for (const Reminder& r : batch)
+    {
+        text += to_string(r.firedOn);
+        text += r.kind == Reminder::Kind::DueSoon ? " due " : " overdue ";
+        text += to_string(r.userId);
+        text += ' ';
+        text += to_string(r.taskId);
+        text += ' ';
+        text += unpackDate(r.dueDate);
+        text += '\n';
+    }
+    file << text;
+    file.flush();
+}
+
+ReminderScheduler::ReminderScheduler(uint32_t today, int lead, size_t batch)
+    : leadDays(lead), batchSize(max<size_t>(1, batch)), now(tickOf(today))
+{
+    for (uint32_t& head : heads) head = NONE;
+}
+
+void ReminderScheduler::attachSink(ReminderSink* s)
+{
+    lock_guard<mutex> guard(lock);
+    sink = s;
+}
+
+uint32_t ReminderScheduler::tickOf(uint32_t date)
+{
+    return static_cast<uint32_t>(dayNumber(date) + TICK_BASE);
+}
+
+void ReminderScheduler::setFireTick(Timer& timer)
+{
+    uint32_t dueTick = tickOf(timer.dueDate);
+    timer.fireTick = timer.kind == Reminder::Kind::DueSoon ? dueTick - leadDays : dueTick + 1;
+}
+
+// Level L holds timers 64^L to 64^(L+1) - 1 ticks away, in the slot picked
+// by bits 6L.. of the fire tick; timers due by now go to READY
+void ReminderScheduler::place(uint32_t index)
+{
+    Timer& timer = timers[index];
+    uint32_t list = READY;
+    if (timer.fireTick > now)
+    {
+        uint32_t distance = timer.fireTick - now;
+        int level = 0;
+        while (level < LEVELS - 1 && distance >= (1u << (SLOT_BITS * (level + 1)))) level++;
+        list = level * SLOTS + ((timer.fireTick >> (SLOT_BITS * level)) & (SLOTS - 1));
+        wheelCount++;
+    }
+
+    timer.list = list;
+    timer.prev = NONE;
+    timer.next = heads[list];
+    if (timer.next != NONE) timers[timer.next].prev = index;
+    heads[list] = index;
+}
+
+void ReminderScheduler::unlink(uint32_t index)
+{
+    Timer& timer = timers[index];
+    if (timer.prev != NONE) timers[timer.prev].next = timer.next;
+    else heads[timer.list] = timer.next;
+    if (timer.next != NONE) timers[timer.next].prev = timer.prev;
+    if (timer.list != READY) wheelCount--;
+    timer.list = NONE;
+}
+
+void ReminderScheduler::release(uint32_t index)
+{
+    timerOfTask.erase(timers[index].taskId);
+    freeTimers.push_back(index);
+}
+
+// The slot's timers are now less than 64^level ticks away - place them again
+// (level 0: due today, so READY)
+void ReminderScheduler::cascade(int level, uint32_t slot)
+{
+    uint32_t list = level * SLOTS + slot;
+    uint32_t index = heads[list];
+    heads[list] = NONE;
+    while (index != NONE)
+    {
+        uint32_t next = timers[index].next;
+        wheelCount--;
+        place(index);
+        index = next;
+    }
+}
+
+void ReminderScheduler::schedule(int userId, int taskId, uint32_t dueDate)
+{
+    lock_guard<mutex> guard(lock);
+    auto found = timerOfTask.find(taskId);
+    if (dueDate == 0)
+    {
+        // No date, nothing to remind of
+        if (found != timerOfTask.end())
+        {
+            unlink(found->second);
+            release(found->second);
+        }
+        return;
+    }
+
+    uint32_t index;
+    if (found != timerOfTask.end())
+    {
+        index = found->second;
+        if (timers[index].dueDate == dueDate && timers[index].userId == userId) return;
+        unlink(index);
+    }
+    else
+    {
+        if (!freeTimers.empty())
+        {
+            index = freeTimers.back();
+            freeTimers.pop_back();
+        }
+        else
+        {
+            index = static_cast<uint32_t>(timers.size());
+            timers.emplace_back();
+        }
+        timerOfTask.emplace(taskId, index);
+    }
+
+    Timer& timer = timers[index];
+    timer.userId = userId;
+    timer.taskId = taskId;
+    timer.dueDate = dueDate;
+    // Already past its due date: too late for "due soon"
+    timer.kind = tickOf(dueDate) < now ? Reminder::Kind::Overdue : Reminder::Kind::DueSoon;
+    setFireTick(timer);
+    place(index);
+}
+
+void ReminderScheduler::cancel(int taskId)
+{
+    lock_guard<mutex> guard(lock);
+    auto found = timerOfTask.find(taskId);
+    if (found == timerOfTask.end()) return;
+    uint32_t index = found->second;
+    unlink(index);
+    release(index);
+}
+
+void ReminderScheduler::clear()
+{
+    lock_guard<mutex> guard(lock);
+    timers.clear();
+    freeTimers.clear();
+    timerOfTask.clear();
+    for (uint32_t& head : heads) head = NONE;
+    wheelCount = 0;
+}
+
+void ReminderScheduler::reserve(size_t tasks)
+{
+    lock_guard<mutex> guard(lock);
+    timers.reserve(tasks);
+    timerOfTask.reserve(tasks);
+}
+
+// Fire READY timers and move the clock a day at a time until target, stopping
+// early when the batch is full. True when the clock has reached target.
+bool ReminderScheduler::step(uint32_t target, vector<Reminder>& batch)
+{
+    while (batch.size() < batchSize)
+    {
+        uint32_t index = heads[READY];
+        if (index != NONE)
+        {
+            unlink(index);
+            Timer& timer = timers[index];
+            batch.push_back({ timer.kind, timer.userId, timer.taskId, timer.dueDate,
+                              packedDateOfDay(static_cast<int32_t>(now - TICK_BASE)) });
+            if (timer.kind == Reminder::Kind::DueSoon)
+            {
+                timer.kind = Reminder::Kind::Overdue;
+                setFireTick(timer);
+                place(index);
+            }
+            else
+            {
+                release(index);
+            }
+            continue;
+        }
+
+        if (now >= target) return true;
+        if (wheelCount == 0)
+        {
+            now = target;                        // Nothing to pass on the way
+            return true;
+        }
+
+        now++;
+        if ((now & (SLOTS - 1)) == 0)
+        {
+            // Start of a 64-day block: bring the next level's slot down, and
+            // at the start of a 4096-day block the one above first
+            uint32_t slot1 = (now >> SLOT_BITS) & (SLOTS - 1);
+            if (slot1 == 0)
+            {
+                uint32_t slot2 = (now >> (2 * SLOT_BITS)) & (SLOTS - 1);
+                if (slot2 == 0) cascade(3, (now >> (3 * SLOT_BITS)) & (SLOTS - 1));
+                cascade(2, slot2);
+            }
+            cascade(1, slot1);
+        }
+
+        cascade(0, now & (SLOTS - 1));           // Today's slot: every timer in it goes to READY
+    }
+    return false;
+}
+
+size_t ReminderScheduler::advanceTo(uint32_t today)
+{
+    uint32_t target = tickOf(today);
+    size_t fired = 0;
+    for (bool done = false; !done;)
+    {
+        vector<Reminder> batch;
+        ReminderSink* to;
+        {
+            lock_guard<mutex> guard(lock);
+            batch.reserve(min(batchSize, timerOfTask.size()));
+            done = step(target, batch);
+            to = sink;
+        }
+        if (!batch.empty() && to) to->deliver(batch);
+        fired += batch.size();
+    }
+    return fired;
+}
+
+uint32_t ReminderScheduler::today() const
+{
+    lock_guard<mutex> guard(lock);
+    return packedDateOfDay(static_cast<int32_t>(now - TICK_BASE));
+}
+
+size_t ReminderScheduler::pending() const
+{
+    lock_guard<mutex> guard(lock);
+    return timerOfTask.size();
+}
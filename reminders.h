@@ -0,0 +1,141 @@
+#ifndef REMINDERS_H
+#define REMINDERS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+using namespace std;
+
+// One reminder event: a task is due soon (leadDays before its due date) or
+// overdue (the day after its due date, still not completed)
+struct Reminder {
+    enum class Kind : uint8_t { DueSoon, Overdue };
+    Kind kind;
+    int userId;
+    int taskId;
+    uint32_t dueDate;       // Packed YYYYMMDD
+    uint32_t firedOn;       // Scheduler date when it fired
+};
+
+// Where fired reminders go - one call per batch, from the thread that advanced
+// the clock and without the scheduler's lock held, so a sink may call back into
+// UserManager
+class ReminderSink {
+public:
+    virtual ~ReminderSink() = default;
+    virtual void deliver(const vector<Reminder>& batch) = 0;
+};
+
+// One line per reminder, the batch written in one go
+class ConsoleReminderSink : public ReminderSink {
+public:
+    explicit ConsoleReminderSink(ostream& out = cout) : out(out) {}
+    void deliver(const vector<Reminder>& batch) override;
+private:
+    ostream& out;
+};
+
+// Appends "YYYYMMDD due|overdue userId taskId DD/MM/YYYY" lines to a spool
+// file for another process to send on; flushed once per batch
+class SpoolReminderSink : public ReminderSink {
+public:
+    explicit SpoolReminderSink(const string& filename) : file(filename, ios::app) {}
+    bool isOpen() const { return file.is_open(); }
+    void deliver(const vector<Reminder>& batch) override;
+private:
+    ofstream file;
+};
+
+class CallbackReminderSink : public ReminderSink {
+public:
+    explicit CallbackReminderSink(function<void(const vector<Reminder>&)> fn) : fn(move(fn)) {}
+    void deliver(const vector<Reminder>& batch) override { fn(batch); }
+private:
+    function<void(const vector<Reminder>&)> fn;
+};
+
+// Due-date reminders for ongoing tasks in a hierarchical timer wheel with one
+// tick per day: 4 levels of 64 slots (1, 64, 4096 and 262144 days per slot).
+// A task sits in one slot list; adding, moving or cancelling it is O(1), and
+// advancing the clock by a day empties one slot, plus a cascade of the slot
+// above into the level below every 64 days. Each task first fires DueSoon on
+// (due date - leadDays), then Overdue the day after its due date, then leaves
+// the wheel. A task already overdue when scheduled only gets the Overdue one.
+//
+// The clock only moves through advanceTo, so the same calls give the same
+// reminders in the same order - the bench drives it with simulated dates.
+// Reminders whose day is already past when a task is scheduled fire on the
+// next advanceTo (delivery is at least once: a restart that reschedules an
+// overdue task sends its Overdue reminder again).
+//
+// Thread safety: every method locks the scheduler; sinks run unlocked.
+class ReminderScheduler {
+public:
+    explicit ReminderScheduler(uint32_t today, int leadDays = 1, size_t batchSize = 1024);
+
+    ReminderScheduler(const ReminderScheduler&) = delete;
+    ReminderScheduler& operator=(const ReminderScheduler&) = delete;
+
+    void attachSink(ReminderSink* s);
+
+    // Add an ongoing task or move it to a new due date; the same date again
+    // changes nothing, so reminders already sent are not repeated
+    void schedule(int userId, int taskId, uint32_t dueDate);
+    void cancel(int taskId);                     // Completed or deleted
+    void clear();
+    void reserve(size_t tasks);
+
+    // Move the clock to today (packed) and fire everything due by then, in
+    // batches of batchSize. Returns the number fired. The clock never goes back.
+    size_t advanceTo(uint32_t today);
+
+    uint32_t today() const;
+    size_t pending() const;                      // Tasks with a reminder still to fire
+
+private:
+    static const int LEVELS = 4;
+    static const int SLOT_BITS = 6;
+    static const uint32_t SLOTS = 1u << SLOT_BITS;
+    static const uint32_t NONE = UINT32_MAX;
+    static const uint32_t READY = LEVELS * SLOTS;   // List of timers due now
+    static const int64_t TICK_BASE = 1000000;       // Day number -> tick, keeps ticks positive
+
+    struct Timer {
+        int userId;
+        int taskId;
+        uint32_t dueDate;
+        uint32_t fireTick;
+        Reminder::Kind kind;
+        uint32_t list;                          // Slot list holding it, NONE when free
+        uint32_t prev;
+        uint32_t next;
+    };
+
+    mutable mutex lock;
+    ReminderSink* sink = nullptr;
+    int leadDays;
+    size_t batchSize;
+
+    uint32_t now;                               // Current tick
+    vector<Timer> timers;                       // Pool, linked into slot lists by index
+    vector<uint32_t> freeTimers;
+    unordered_map<int, uint32_t> timerOfTask;
+    uint32_t heads[LEVELS * SLOTS + 1];         // Slot lists, READY last
+    size_t wheelCount = 0;                      // Timers in slots (not READY)
+
+    static uint32_t tickOf(uint32_t date);
+    void setFireTick(Timer& timer);
+    void place(uint32_t index);                 // Into the slot for its fire tick, or READY
+    void unlink(uint32_t index);
+    void release(uint32_t index);
+    void cascade(int level, uint32_t slot);
+    bool step(uint32_t target, vector<Reminder>& batch);
+};
+
+#endif
@@ -0,0 +1,825 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string_view>
+#include <unordered_map>
+#include "blockcodec.h"
+#include "snapshot.h"
+#include "usermanager.h"
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <fcntl.h>
+#include <io.h>
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Map a whole file read-only
+bool MappedFile::open(const string& filename)
+{
+    close();
+
+#ifdef _WIN32
+    ifstream file(filename, ios::binary | ios::ate);
+    if (!file.is_open()) return false;
+
+    buffer.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    if (!buffer.empty() && !file.read(buffer.data(), buffer.size())) return false;
+
+    ptr = buffer.data();
+    length = buffer.size();
+    return true;
+#else
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0)
+    {
+        ::close(fd);
+        return false;
+    }
+
+    void* addr = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // The mapping stays valid after the descriptor is closed
+    if (addr == MAP_FAILED) return false;
+
+    madvise(addr, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+    ptr = static_cast<const char*>(addr);
+    length = static_cast<size_t>(st.st_size);
+    return true;
+#endif
+}
+
+void MappedFile::close()
+{
+#ifdef _WIN32
+    buffer.clear();
+#else
+    if (ptr)
+    {
+        munmap(const_cast<char*>(ptr), length);
+    }
+#endif
+    ptr = nullptr;
+    length = 0;
+}
+
+namespace
+{
+// Flush a written and closed file's data to the disk
+bool syncFile(const string& name)
+{
+#ifdef _WIN32
+    int fd = _open(name.c_str(), _O_RDWR | _O_BINARY);
+    if (fd < 0) return false;
+    bool synced = _commit(fd) == 0;
+    _close(fd);
+#else
+    int fd = ::open(name.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    bool synced = ::fsync(fd) == 0;
+    ::close(fd);
+#endif
+    return synced;
+}
+
+// Swap the synced temporary file in for target in one step, then make the
+// rename itself durable: at any moment the old or the new snapshot is there
+bool replaceFile(const string& temp, const string& target)
+{
+#ifdef _WIN32
+    return MoveFileExA(temp.c_str(), target.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    if (rename(temp.c_str(), target.c_str()) != 0) return false;
+    size_t slash = target.find_last_of('/');
+    string directory = slash == string::npos ? "." : (slash == 0 ? "/" : target.substr(0, slash));
+    int fd = ::open(directory.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    bool synced = ::fsync(fd) == 0;
+    ::close(fd);
+    return synced;
+#endif
+}
+
+// Buffered little-endian writer on top of an ofstream
+class SnapshotWriter
+{
+private:
+    ofstream& out;
+    string buffer;
+    uint64_t written;
+
+public:
+    explicit SnapshotWriter(ofstream& file) : out(file), written(0)
+    {
+        buffer.reserve(1 << 20);
+    }
+
+    void bytes(const void* data, size_t size)
+    {
+        buffer.append(static_cast<const char*>(data), size);
+        written += size;
+        if (buffer.size() >= (1 << 20)) flush();
+    }
+
+    template <typename T>
+    void value(T v)
+    {
+        bytes(&v, sizeof(v));
+    }
+
+    void lengthPrefixed(const string& s)
+    {
+        uint16_t len = static_cast<uint16_t>(min<size_t>(s.size(), UINT16_MAX));
+        value(len);
+        bytes(s.data(), len);
+    }
+
+    void padTo(size_t alignment)
+    {
+        while (written % alignment != 0) value<uint8_t>(0);
+    }
+
+    void flush()
+    {
+        out.write(buffer.data(), buffer.size());
+        buffer.clear();
+    }
+
+    uint64_t position() const { return written; }
+};
+
+// Version 2 record stream, cut into blocks that are compressed (or not) and
+// written as each one fills
+class CompactWriter
+{
+private:
+    ofstream& out;
+    bool compress;
+    string block;
+    vector<char> packed;
+    uint64_t written;
+
+    void flushBlock()
+    {
+        uint32_t header[2] = { static_cast<uint32_t>(block.size()), static_cast<uint32_t>(block.size()) };
+        const char* payload = block.data();
+        if (compress && !block.empty())
+        {
+            packed.resize(compressBound(block.size()));
+            size_t size = compressBlock(block.data(), block.size(), packed.data());
+            if (size < block.size())
+            {
+                header[1] = static_cast<uint32_t>(size);
+                payload = packed.data();
+            }
+        }
+        out.write(reinterpret_cast<const char*>(header), sizeof(header));
+        out.write(payload, header[1]);
+        written += sizeof(header) + header[1];
+        block.clear();
+    }
+
+public:
+    CompactWriter(ofstream& file, bool compressBlocks) : out(file), compress(compressBlocks), written(0)
+    {
+        block.reserve(SNAPSHOT_BLOCK_SIZE + 4096);
+    }
+
+    void raw(const void* data, size_t size)
+    {
+        out.write(static_cast<const char*>(data), size);
+        written += size;
+    }
+
+    void byte(uint8_t v) { block.push_back(static_cast<char>(v)); }
+
+    void varint(uint64_t v)
+    {
+        while (v >= 0x80)
+        {
+            block.push_back(static_cast<char>(v | 0x80));
+            v >>= 7;
+        }
+        block.push_back(static_cast<char>(v));
+    }
+
+    void signedVarint(int64_t v) { varint((static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63)); }
+
+    void text(const char* data, size_t size)
+    {
+        varint(size);
+        block.append(data, size);
+    }
+
+    // Blocks end only between records
+    void endRecord()
+    {
+        if (block.size() >= SNAPSHOT_BLOCK_SIZE) flushBlock();
+    }
+
+    void finish()
+    {
+        if (!block.empty()) flushBlock();
+        flushBlock(); // Empty block: end of file
+    }
+
+    uint64_t position() const { return written; }
+};
+
+// Reads the blocks back one at a time; records never cross a block, so
+// running off the end of one is damage
+class CompactReader
+{
+private:
+    ifstream& in;
+    string block;
+    vector<char> packed;
+    size_t pos;
+
+public:
+    bool corrupt;
+    uint64_t bytesRead;
+
+    explicit CompactReader(ifstream& file) : in(file), pos(0), corrupt(false), bytesRead(0) {}
+
+    // Next block, false at the end marker or on damage
+    bool nextBlock()
+    {
+        uint32_t header[2];
+        if (!in.read(reinterpret_cast<char*>(header), sizeof(header)) ||
+                header[0] > SNAPSHOT_MAX_BLOCK || header[1] > header[0])
+        {
+            corrupt = true;
+            return false;
+        }
+        bytesRead += sizeof(header) + header[1];
+        if (header[0] == 0) return false;
+
+        block.resize(header[0]);
+        pos = 0;
+        if (header[1] == header[0])
+        {
+            if (!in.read(&block[0], header[0])) corrupt = true;
+        }
+        else
+        {
+            packed.resize(header[1]);
+            if (!in.read(packed.data(), header[1]) ||
+                    !decompressBlock(packed.data(), header[1], &block[0], header[0]))
+            {
+                corrupt = true;
+            }
+        }
+        return !corrupt;
+    }
+
+    bool atEnd() const { return pos == block.size(); }
+
+    uint8_t byte()
+    {
+        if (pos == block.size())
+        {
+            corrupt = true;
+            return 0;
+        }
+        return static_cast<uint8_t>(block[pos++]);
+    }
+
+    uint64_t varint()
+    {
+        uint64_t v = 0;
+        for (int shift = 0; shift < 64; shift += 7)
+        {
+            if (pos == block.size()) break;
+            uint8_t b = static_cast<uint8_t>(block[pos++]);
+            v |= static_cast<uint64_t>(b & 0x7f) << shift;
+            if (b < 0x80) return v;
+        }
+        corrupt = true;
+        return 0;
+    }
+
+    int64_t signedVarint()
+    {
+        uint64_t v = varint();
+        return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+    }
+
+    // Next ID of a delta-coded sequence; damage unless it is a valid int ID
+    int nextId(int previous)
+    {
+        int64_t delta = signedVarint();
+        int64_t id = delta > -INT_MAX - 1LL && delta < INT_MAX * 2LL ? previous + delta : 0;
+        if (id <= 0 || id > INT_MAX)
+        {
+            corrupt = true;
+            return 0;
+        }
+        return static_cast<int>(id);
+    }
+
+    void text(string& out)
+    {
+        uint64_t size = varint();
+        if (corrupt || size > block.size() - pos)
+        {
+            corrupt = true;
+            return;
+        }
+        out.assign(block, pos, static_cast<size_t>(size));
+        pos += static_cast<size_t>(size);
+    }
+};
+
+// Version 1: header, user records, padding, fixed-width task records, title pool
+uint64_t writeFixedRecords(ofstream& file, SnapshotHeader& header, const vector<const User*>& users)
+{
+    SnapshotWriter writer(file);
+    writer.value(header); // Rewritten with the section offsets at the end
+
+    for (const User* user : users)
+    {
+        writer.value<int32_t>(user->id);
+        writer.value<uint8_t>(user->isActive ? 1 : 0);
+        writer.value<uint32_t>(static_cast<uint32_t>(user->tasks.size()));
+        writer.lengthPrefixed(user->username);
+        writer.lengthPrefixed(user->email);
+        writer.lengthPrefixed(user->password);
+    }
+
+    writer.padTo(8);
+    header.taskSectionOffset = writer.position();
+
+    string titlePool;
+    for (const User* user : users)
+    {
+        for (const auto& taskPair : user->tasks)
+        {
+            const Task& task = taskPair.second;
+            SnapshotTaskRecord record = {};
+            record.taskId = task.taskId;
+            record.ownerId = user->id;
+            record.dueDate = task.dueDate;
+            record.titleOffset = static_cast<uint32_t>(titlePool.size());
+            record.titleLength = static_cast<uint16_t>(min<size_t>(task.title.size(), UINT16_MAX));
+            record.status = (task.status == "Completed") ? SNAPSHOT_STATUS_COMPLETED : SNAPSHOT_STATUS_ONGOING;
+            titlePool.append(task.title, 0, record.titleLength);
+            writer.value(record);
+        }
+    }
+
+    header.titlePoolOffset = writer.position();
+    header.titlePoolSize = titlePool.size();
+    writer.bytes(titlePool.data(), titlePool.size());
+    writer.flush();
+
+    file.seekp(0);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    return writer.position();
+}
+
+// Version 2: the compact record stream, see snapshot.h
+uint64_t writeCompactRecords(ofstream& file, const CompactSnapshotHeader& header,
+                             const vector<const User*>& users, bool compress)
+{
+    CompactWriter writer(file, compress);
+    writer.raw(&header, sizeof(header));
+
+    // Titles are looked up by view - the tasks outlive the save under lockAll
+    unordered_map<uint32_t, uint32_t> dateCodes;
+    unordered_map<string_view, uint32_t> titleCodes;
+    dateCodes.reserve(4096);
+    titleCodes.reserve(4096);
+
+    vector<const Task*> tasks;
+    int previousUser = 0;
+    int previousTask = 0;
+    for (const User* user : users)
+    {
+        writer.signedVarint(static_cast<int64_t>(user->id) - previousUser);
+        writer.byte(user->isActive ? 1 : 0);
+        writer.varint(user->tasks.size());
+        writer.text(user->username.data(), user->username.size());
+        writer.text(user->email.data(), user->email.size());
+        writer.text(user->password.data(), user->password.size());
+        writer.endRecord();
+        previousUser = user->id;
+
+        // ID order keeps the deltas small: IDs come from one rising counter
+        tasks.clear();
+        for (const auto& taskPair : user->tasks) tasks.push_back(&taskPair.second);
+        sort(tasks.begin(), tasks.end(), [](const Task* a, const Task* b) { return a->taskId < b->taskId; });
+
+        for (const Task* task : tasks)
+        {
+            writer.signedVarint(static_cast<int64_t>(task->taskId) - previousTask);
+            previousTask = task->taskId;
+
+            uint64_t completed = task->status == "Completed" ? 1 : 0;
+            auto date = dateCodes.find(task->dueDate);
+            if (date != dateCodes.end())
+            {
+                writer.varint(static_cast<uint64_t>(date->second) << 1 | completed);
+            }
+            else
+            {
+                writer.varint(completed);
+                writer.varint(task->dueDate);
+                if (dateCodes.size() < SNAPSHOT_DICTIONARY_LIMIT)
+                {
+                    dateCodes.emplace(task->dueDate, static_cast<uint32_t>(dateCodes.size() + 1));
+                }
+            }
+
+            string_view title(task->title.data(), task->title.size());
+            auto code = titleCodes.find(title);
+            if (code != titleCodes.end())
+            {
+                writer.varint(code->second);
+            }
+            else
+            {
+                writer.varint(0);
+                writer.text(title.data(), title.size());
+                if (titleCodes.size() < SNAPSHOT_DICTIONARY_LIMIT)
+                {
+                    titleCodes.emplace(title, static_cast<uint32_t>(titleCodes.size() + 1));
+                }
+            }
+            writer.endRecord();
+        }
+    }
+
+    writer.finish();
+    return writer.position();
+}
+}
+
+// Save all users and tasks as a versioned binary snapshot
+bool UserManager::saveSnapshot(const string& filename, SnapshotEncoding encoding)
+{
+    OP_TIMER(Op::SaveSnapshot);
+    auto locks = lockAll();
+    uint64_t bytes = 0;
+    bool saved = writeSnapshot(filename, &bytes, encoding);
+    OP_BYTES(bytes);
+    return saved;
+}
+
+bool UserManager::writeSnapshot(const string& filename, uint64_t* bytesWritten, SnapshotEncoding encoding)
+{
+    // Same user selection and ID order as the text format
+    vector<const User*> users;
+    users.reserve(userCount);
+    uint64_t taskCount = 0;
+    forEachUserById([&](const User& user)
+    {
+        if (user.id > 0 && !user.username.empty() && !user.email.empty())
+        {
+            users.push_back(&user);
+            taskCount += user.tasks.size();
+        }
+    });
+
+    // Write to a temporary file and swap it in so a failed save keeps the old snapshot
+    string tempName = filename + ".tmp";
+    ofstream file(tempName, ios::binary | ios::trunc);
+    if (!file.is_open())
+    {
+        cerr << "Error: Could not save snapshot to file " << filename << endl;
+        return false;
+    }
+
+    uint64_t written;
+    if (encoding == SnapshotEncoding::Fixed)
+    {
+        SnapshotHeader header = {};
+        memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+        header.version = SNAPSHOT_VERSION;
+        header.userCount = users.size();
+        header.taskCount = taskCount;
+        header.userIdCounter = userIdCounter;
+        header.taskIdCounter = taskIdCounter;
+        written = writeFixedRecords(file, header, users);
+    }
+    else
+    {
+        CompactSnapshotHeader header = {};
+        memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+        header.version = SNAPSHOT_VERSION_COMPACT;
+        header.flags = encoding == SnapshotEncoding::Compressed ? SNAPSHOT_FLAG_COMPRESSED : 0;
+        header.blockSize = SNAPSHOT_BLOCK_SIZE;
+        header.userCount = users.size();
+        header.taskCount = taskCount;
+        header.userIdCounter = userIdCounter;
+        header.taskIdCounter = taskIdCounter;
+        written = writeCompactRecords(file, header, users, encoding == SnapshotEncoding::Compressed);
+    }
+
+    if (bytesWritten) *bytesWritten = written;
+    file.close();
+    if (!file || !syncFile(tempName))
+    {
+        cerr << "Error: Could not save snapshot to file " << filename << endl;
+        remove(tempName.c_str());
+        return false;
+    }
+
+    // Only a snapshot that is on disk may replace the old one (checkpoint then empties the journal)
+    if (!replaceFile(tempName, filename))
+    {
+        cerr << "Error: Could not replace snapshot file " << filename << endl;
+        return false;
+    }
+
+    cout << "Snapshot saved successfully to " << filename << endl;
+    return true;
+}
+
+// Load a binary snapshot of either version, picked by the header
+bool UserManager::loadSnapshot(const string& filename)
+{
+    OP_TIMER(Op::LoadSnapshot);
+    char head[8] = {};
+    uint32_t version = 0;
+    {
+        ifstream probe(filename, ios::binary);
+        if (!probe.is_open())
+        {
+            cerr << "Error: Could not open snapshot file " << filename << endl;
+            return false;
+        }
+        probe.read(head, sizeof(head));
+        memcpy(&version, head + 4, sizeof(version));
+    }
+
+    uint64_t bytes = 0;
+    bool loaded = memcmp(head, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) == 0 && version == SNAPSHOT_VERSION_COMPACT
+                  ? loadCompactSnapshot(filename, &bytes)
+                  : loadFixedSnapshot(filename, &bytes);
+    OP_BYTES(bytes);
+    return loaded;
+}
+
+// Version 2, decoded a block at a time as it is read
+bool UserManager::loadCompactSnapshot(const string& filename, uint64_t* bytesRead)
+{
+    ifstream file(filename, ios::binary);
+    CompactSnapshotHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+    {
+        cerr << "Error: Snapshot file " << filename << " is truncated" << endl;
+        return false;
+    }
+    if (header.flags & ~SNAPSHOT_FLAG_COMPRESSED)
+    {
+        cerr << "Error: Unsupported snapshot flags " << header.flags << endl;
+        return false;
+    }
+
+    // The counts are not trusted until the file could hold that many records
+    file.seekg(0, ios::end);
+    uint64_t fileBytes = static_cast<uint64_t>(file.tellg()) - sizeof(header);
+    file.seekg(sizeof(header));
+    uint64_t streamBytes = fileBytes * ((header.flags & SNAPSHOT_FLAG_COMPRESSED) ? BLOCK_MAX_EXPANSION : 1);
+    if (header.userCount > streamBytes / SNAPSHOT_MIN_COMPACT_USER ||
+            header.taskCount > streamBytes / SNAPSHOT_MIN_COMPACT_TASK)
+    {
+        cerr << "Error: Snapshot file " << filename << " is corrupt" << endl;
+        return false;
+    }
+
+    // Reserved space is a hint, kept to what the stored bytes could hold
+    reserveUsers(static_cast<size_t>(min(header.userCount, fileBytes / SNAPSHOT_MIN_COMPACT_USER)));
+
+    static const string ONGOING = "Ongoing";
+    static const string COMPLETED = "Completed";
+    vector<uint32_t> dates;
+    vector<string> titles;
+    string username, email, password, title;
+
+    CompactReader reader(file);
+    User* user = nullptr;
+    uint64_t usersLeft = header.userCount;
+    uint64_t tasksLeft = 0;            // Of the current user
+    uint64_t tasksAhead = header.taskCount;
+    int userId = 0;
+    int taskId = 0;
+    while (!reader.corrupt && reader.nextBlock())
+    {
+        while (!reader.atEnd() && !reader.corrupt)
+        {
+            if (tasksLeft == 0)
+            {
+                userId = reader.nextId(userId);
+                bool active = reader.byte() != 0;
+                tasksLeft = reader.varint();
+                reader.text(username);
+                reader.text(email);
+                reader.text(password);
+                if (reader.corrupt || usersLeft == 0 || tasksLeft > tasksAhead)
+                {
+                    reader.corrupt = true;
+                    break;
+                }
+                usersLeft--;
+                tasksAhead -= tasksLeft;
+                user = restoreUser(userId, username, email, password, active);
+                user->tasks.reserve(static_cast<size_t>(min(tasksLeft, fileBytes / SNAPSHOT_MIN_COMPACT_TASK)));
+                continue;
+            }
+
+            taskId = reader.nextId(taskId);
+            uint64_t dateCode = reader.varint();
+            uint32_t dueDate;
+            if ((dateCode >> 1) == 0)
+            {
+                dueDate = static_cast<uint32_t>(reader.varint());
+                if (dates.size() < SNAPSHOT_DICTIONARY_LIMIT) dates.push_back(dueDate);
+            }
+            else if ((dateCode >> 1) <= dates.size())
+            {
+                dueDate = dates[(dateCode >> 1) - 1];
+            }
+            else
+            {
+                reader.corrupt = true;
+                break;
+            }
+
+            uint64_t titleCode = reader.varint();
+            if (titleCode == 0)
+            {
+                reader.text(title);
+                if (titles.size() < SNAPSHOT_DICTIONARY_LIMIT) titles.push_back(title);
+            }
+            else if (titleCode <= titles.size())
+            {
+                title = titles[titleCode - 1];
+            }
+            else
+            {
+                reader.corrupt = true;
+                break;
+            }
+
+            if (reader.corrupt) break;
+            restoreTask(user, taskId, title, dueDate, (dateCode & 1) ? COMPLETED : ONGOING);
+            tasksLeft--;
+        }
+    }
+    if (usersLeft != 0 || tasksLeft != 0 || tasksAhead != 0) reader.corrupt = true;
+    if (bytesRead) *bytesRead = sizeof(header) + reader.bytesRead;
+
+    userIdCounter = max(userIdCounter.load(), static_cast<int>(header.userIdCounter));
+    taskIdCounter = max(taskIdCounter.load(), static_cast<int>(header.taskIdCounter));
+#ifndef NDEBUG
+    statisticsConsistent();
+#endif
+
+    if (reader.corrupt)
+    {
+        cerr << "Error: Snapshot file " << filename << " is corrupt, data was only partially loaded" << endl;
+        return false;
+    }
+
+    cout << "Snapshot loaded successfully." << endl;
+    return true;
+}
+
+// Version 1, read through a read-only mapping of the file
+bool UserManager::loadFixedSnapshot(const string& filename, uint64_t* bytesRead)
+{
+    MappedFile file;
+    if (!file.open(filename))
+    {
+        cerr << "Error: Could not open snapshot file " << filename << endl;
+        return false;
+    }
+
+    const char* base = file.data();
+    const size_t size = file.size();
+    if (bytesRead) *bytesRead = size;
+
+    SnapshotHeader header;
+    if (size < sizeof(header))
+    {
+        cerr << "Error: Snapshot file " << filename << " is truncated" << endl;
+        return false;
+    }
+    memcpy(&header, base, sizeof(header));
+
+    if (memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0)
+    {
+        cerr << "Error: " << filename << " is not a snapshot file" << endl;
+        return false;
+    }
+    if (header.version != SNAPSHOT_VERSION)
+    {
+        cerr << "Error: Unsupported snapshot version " << header.version << endl;
+        return false;
+    }
+    if (header.taskSectionOffset > size || header.taskSectionOffset < sizeof(header) ||
+            header.userCount > (header.taskSectionOffset - sizeof(header)) / SNAPSHOT_MIN_USER_RECORD ||
+            header.taskCount > (size - header.taskSectionOffset) / sizeof(SnapshotTaskRecord) ||
+            header.titlePoolOffset > size ||
+            header.titlePoolSize > size - header.titlePoolOffset)
+    {
+        cerr << "Error: Snapshot file " << filename << " is truncated" << endl;
+        return false;
+    }
+
+    // Size every index once up front
+    reserveUsers(header.userCount);
+
+    const char* cursor = base + sizeof(header);
+    const char* userEnd = base + header.taskSectionOffset;
+    const char* records = base + header.taskSectionOffset;
+    const char* pool = base + header.titlePoolOffset;
+    uint64_t nextTask = 0;
+    bool corrupt = false;
+
+    auto readBytes = [&](void* out, size_t count) {
+        if (static_cast<size_t>(userEnd - cursor) < count)
+        {
+            corrupt = true;
+            return;
+        }
+        memcpy(out, cursor, count);
+        cursor += count;
+    };
+    auto readString = [&](string& out) {
+        uint16_t len = 0;
+        readBytes(&len, sizeof(len));
+        if (corrupt || static_cast<size_t>(userEnd - cursor) < len)
+        {
+            corrupt = true;
+            return;
+        }
+        out.assign(cursor, len);
+        cursor += len;
+    };
+
+    string username, email, password, title;
+    for (uint64_t i = 0; i < header.userCount && !corrupt; i++)
+    {
+        int32_t id = 0;
+        uint8_t active = 0;
+        uint32_t taskCount = 0;
+        readBytes(&id, sizeof(id));
+        readBytes(&active, sizeof(active));
+        readBytes(&taskCount, sizeof(taskCount));
+        readString(username);
+        readString(email);
+        readString(password);
+        if (corrupt || id <= 0 || taskCount > header.taskCount - nextTask)
+        {
+            corrupt = true;
+            break;
+        }
+
+        User* user = restoreUser(id, username, email, password, active != 0);
+        user->tasks.reserve(taskCount);
+
+        for (uint32_t t = 0; t < taskCount; t++, nextTask++)
+        {
+            SnapshotTaskRecord record;
+            memcpy(&record, records + nextTask * sizeof(record), sizeof(record));
+            // A record must belong to the user it is listed under
+            if (record.taskId <= 0 || record.ownerId != id ||
+                    static_cast<uint64_t>(record.titleOffset) + record.titleLength > header.titlePoolSize)
+            {
+                corrupt = true;
+                break;
+            }
+
+            title.assign(pool + record.titleOffset, record.titleLength);
+            restoreTask(user, record.taskId, title, record.dueDate,
+                        record.status == SNAPSHOT_STATUS_COMPLETED ? "Completed" : "Ongoing");
+        }
+    }
+
+    userIdCounter = max(userIdCounter.load(), static_cast<int>(header.userIdCounter));
+    taskIdCounter = max(taskIdCounter.load(), static_cast<int>(header.taskIdCounter));
+#ifndef NDEBUG
+    statisticsConsistent();
+#endif
+
+    if (corrupt)
+    {
+        cerr << "Error: Snapshot file " << filename << " is corrupt, data was only partially loaded" << endl;
+        return false;
+    }
+
+    cout << "Snapshot loaded successfully." << endl;
+    return true;
+}
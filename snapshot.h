@@ -0,0 +1,119 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+using namespace std;
+
+// Binary snapshot layout (little-endian, version 1):
+//
+//   SnapshotHeader
+//   user records   - id(i32) active(u8) taskCount(u32) then username, email and
+//                    password as u16 length + bytes; tasks of a user follow in
+//                    the same order in the task section
+//   padding        - task section starts on an 8 byte boundary
+//   task records   - SnapshotTaskRecord[taskCount], fixed width
+//   title pool     - raw title bytes addressed by titleOffset/titleLength
+const char SNAPSHOT_MAGIC[4] = { 'M', 'U', 'T', 'P' };
+const uint32_t SNAPSHOT_VERSION = 1;
+
+struct SnapshotHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t userCount;
+    uint64_t taskCount;
+    uint64_t taskSectionOffset;
+    uint64_t titlePoolOffset;
+    uint64_t titlePoolSize;
+    int32_t userIdCounter;
+    int32_t taskIdCounter;
+};
+
+// Task status codes stored in SnapshotTaskRecord::status
+const uint8_t SNAPSHOT_STATUS_ONGOING = 0;
+const uint8_t SNAPSHOT_STATUS_COMPLETED = 1;
+
+struct SnapshotTaskRecord {
+    int32_t taskId;
+    int32_t ownerId;
+    uint32_t dueDate;       // Packed as YYYYMMDD, 0 when the stored date was not parseable
+    uint32_t titleOffset;   // Offset into the title pool
+    uint16_t titleLength;
+    uint8_t status;
+    uint8_t reserved;
+};
+
+static_assert(sizeof(SnapshotHeader) == 56, "snapshot header must stay 56 bytes");
+static_assert(sizeof(SnapshotTaskRecord) == 20, "snapshot task record must stay 20 bytes");
+
+// Smallest user record: id, active, taskCount and three empty strings
+const uint64_t SNAPSHOT_MIN_USER_RECORD = 4 + 1 + 4 + 3 * 2;
+
+// Compact snapshot layout (version 2, the default):
+//
+//   CompactSnapshotHeader
+//   blocks         - rawSize(u32) storedSize(u32) then storedSize bytes, the
+//                    block compressed with blockcodec.h, or as is when
+//                    storedSize == rawSize; rawSize 0 ends the file
+//
+// The blocks carry one record stream, cut only between records, so save and
+// load hold one block at a time:
+//   user record    - zigzag varint ID delta from the previous user, active(u8),
+//                    varint taskCount, then username, email and password as
+//                    varint length + bytes; the user's tasks follow in ID order
+//   task record    - zigzag varint task ID delta from the previous task,
+//                    varint (date code << 1 | completed), varint title code
+// Dates and titles are dictionary coded as they stream: code 0 is a new value
+// in full (the packed date as a varint, the title as length + bytes) that
+// joins the dictionary while it has room, code k is dictionary entry k - 1.
+const uint32_t SNAPSHOT_VERSION_COMPACT = 2;
+const uint32_t SNAPSHOT_FLAG_COMPRESSED = 1;
+const uint32_t SNAPSHOT_BLOCK_SIZE = 256 * 1024;
+const uint32_t SNAPSHOT_MAX_BLOCK = 64 * 1024 * 1024;    // Larger raw sizes are damage
+const size_t SNAPSHOT_DICTIONARY_LIMIT = 1 << 16;        // Entries per dictionary
+const uint64_t SNAPSHOT_MIN_COMPACT_USER = 6;            // Stream bytes of the smallest user record
+const uint64_t SNAPSHOT_MIN_COMPACT_TASK = 3;            // and of the smallest task record
+
+struct CompactSnapshotHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t flags;
+    uint32_t blockSize;     // Blocks are cut at the first record boundary past this
+    uint64_t userCount;
+    uint64_t taskCount;
+    int32_t userIdCounter;
+    int32_t taskIdCounter;
+};
+
+static_assert(sizeof(CompactSnapshotHeader) == 40, "compact snapshot header must stay 40 bytes");
+
+// What saveSnapshot writes: the fixed-width version 1 layout, or version 2
+// with or without block compression. loadSnapshot reads all three.
+enum class SnapshotEncoding { Fixed, Compact, Compressed };
+
+// Read-only view of a whole file - mmap on POSIX, a single read elsewhere
+class MappedFile {
+private:
+    const char* ptr;
+    size_t length;
+#ifdef _WIN32
+    vector<char> buffer;
+#endif
+
+public:
+    MappedFile() : ptr(nullptr), length(0) {}
+    ~MappedFile() { close(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const string& filename);
+    void close();
+
+    const char* data() const { return ptr; }
+    size_t size() const { return length; }
+};
+
+#endif
@@ -0,0 +1,92 @@
+#include <charconv>
+#include "tablerenderer.h"
+
+TableRenderer::TableRenderer(ostream& out, vector<Column> columns, size_t pageRows)
+    : out(out), columns(move(columns)), pageRows(pageRows ? pageRows : 1), rowWidth(0)
+{
+    for (const Column& column : this->columns)
+    {
+        rowWidth += column.width;
+    }
+    buffer.reserve((rowWidth + 1) * this->pageRows);
+}
+
+void TableRenderer::header()
+{
+    for (const Column& column : columns)
+    {
+        pad(column.header, column);
+    }
+    buffer += '\n';
+    buffer.append(rowWidth, '-');
+    buffer += '\n';
+    pending += 2;
+}
+
+TableRenderer& TableRenderer::cell(string_view text)
+{
+    if (nextColumn < columns.size())
+    {
+        pad(text, columns[nextColumn++]);
+    }
+    return *this;
+}
+
+TableRenderer& TableRenderer::cell(long long value)
+{
+    char digits[24];
+    auto result = to_chars(digits, digits + sizeof(digits), value);
+    return cell(string_view(digits, static_cast<size_t>(result.ptr - digits)));
+}
+
+void TableRenderer::endRow()
+{
+    // Missing cells are blank so the next row starts aligned
+    while (nextColumn < columns.size())
+    {
+        pad("", columns[nextColumn++]);
+    }
+    nextColumn = 0;
+    buffer += '\n';
+    rows++;
+    rowDone();
+}
+
+void TableRenderer::line(string_view text)
+{
+    buffer.append(text.data(), text.size());
+    buffer += '\n';
+    rowDone();
+}
+
+void TableRenderer::flush()
+{
+    if (buffer.empty()) return;
+    out.write(buffer.data(), static_cast<streamsize>(buffer.size()));
+    buffer.clear();
+    pending = 0;
+}
+
+// Same layout as setw: short text is padded to the width, long text either
+// overflows or is cut to width - 1 characters ending in "..."
+void TableRenderer::pad(string_view text, const Column& column)
+{
+    size_t width = column.width;
+    if (column.truncate && width > 4 && text.size() > width - 1)
+    {
+        buffer.append(text.data(), width - 4);
+        buffer += "...";
+        buffer += ' ';
+        return;
+    }
+
+    size_t fill = text.size() < width ? width - text.size() : 0;
+    if (column.align == Align::Right) buffer.append(fill, ' ');
+    buffer.append(text.data(), text.size());
+    if (column.align == Align::Left) buffer.append(fill, ' ');
+}
+
+void TableRenderer::rowDone()
+{
+    if (++pending >= pageRows) flush();
+}
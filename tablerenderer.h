@@ -0,0 +1,66 @@
+#ifndef TABLE_RENDERER_H
+#define TABLE_RENDERER_H
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+using namespace std;
+
+// Fixed-width text table for the console listings. Rows are formatted into
+// one preallocated buffer (integers with to_chars, padding from the column
+// widths computed up front) and the buffer goes to the stream in a single
+// write per page, so a long listing costs a few large writes instead of
+// several formatted inserts and a flush per row.
+class TableRenderer {
+public:
+    enum class Align { Left, Right };
+
+    struct Column {
+        const char* header;
+        uint16_t width;        // Cell width including the gap to the next column
+        Align align;
+        bool truncate;         // Cut longer text to width - 1 ending in "..."; otherwise let it overflow
+    };
+
+    static const size_t DEFAULT_PAGE_ROWS = 512;
+
+    TableRenderer(ostream& out, vector<Column> columns, size_t pageRows = DEFAULT_PAGE_ROWS);
+    ~TableRenderer() { flush(); }
+
+    TableRenderer(const TableRenderer&) = delete;
+    TableRenderer& operator=(const TableRenderer&) = delete;
+
+    // Column titles and a rule as wide as the table
+    void header();
+
+    // Cells are filled left to right; endRow() closes the row
+    TableRenderer& cell(string_view text);
+    TableRenderer& cell(long long value);
+    void endRow();
+
+    // Free text line (section titles, empty-result notes) in the same buffer
+    void line(string_view text);
+
+    // Write the buffered rows, if any
+    void flush();
+
+    size_t rowCount() const { return rows; }
+    size_t width() const { return rowWidth; }
+
+private:
+    ostream& out;
+    vector<Column> columns;
+    size_t pageRows;
+    size_t rowWidth;           // Sum of the column widths
+    size_t nextColumn = 0;
+    size_t pending = 0;        // Rows in the buffer since the last write
+    size_t rows = 0;
+    string buffer;
+
+    void pad(string_view text, const Column& column);
+    void rowDone();
+};
+
+#endif
@@ -0,0 +1,110 @@
+#include <algorithm>
+#include "taskcolumns.h"
+#include "usermanager.h"
+
+void TaskColumns::clear()
+{
+    taskId.clear();
+    ownerId.clear();
+    dueDate.clear();
+    status.clear();
+    titleOffset.clear();
+    titlePool.clear();
+    users.clear();
+}
+
+void TaskColumns::build(const UserManager& um)
+{
+    clear();
+
+    // Owners in ID order so each user's rows are contiguous and findUser can binary search
+    vector<const User*> owners;
+    size_t totalTasks = 0, totalTitleBytes = 0;
+    owners.reserve(um.getTotalUsersCount());
+    um.forEachUserById([&](const User& user)
+    {
+        owners.push_back(&user);
+        totalTasks += user.tasks.size();
+        for (const auto& taskPair : user.tasks)
+        {
+            totalTitleBytes += taskPair.second.title.size();
+        }
+    });
+
+    taskId.reserve(totalTasks);
+    ownerId.reserve(totalTasks);
+    dueDate.reserve(totalTasks);
+    status.reserve(totalTasks);
+    titleOffset.reserve(totalTasks + 1);
+    titlePool.reserve(totalTitleBytes);
+    users.reserve(owners.size());
+
+    for (const User* user : owners)
+    {
+        UserRange range = { user->id, user->isActive, static_cast<uint32_t>(taskId.size()), 0 };
+        for (const auto& taskPair : user->tasks)
+        {
+            const Task& task = taskPair.second;
+            taskId.push_back(task.taskId);
+            ownerId.push_back(user->id);
+            dueDate.push_back(task.dueDate);
+            status.push_back(task.status == "Completed" ? COLUMN_STATUS_COMPLETED : COLUMN_STATUS_ONGOING);
+            titleOffset.push_back(static_cast<uint32_t>(titlePool.size()));
+            titlePool += task.title;
+        }
+        range.end = static_cast<uint32_t>(taskId.size());
+        users.push_back(range);
+    }
+    titleOffset.push_back(static_cast<uint32_t>(titlePool.size()));
+}
+
+string_view TaskColumns::title(size_t row) const
+{
+    return string_view(titlePool.data() + titleOffset[row], titleOffset[row + 1] - titleOffset[row]);
+}
+
+const TaskColumns::UserRange* TaskColumns::findUser(int userId) const
+{
+    auto it = lower_bound(users.begin(), users.end(), userId, [](const UserRange& r, int id)
+    {
+        return r.userId < id;
+    });
+    return (it != users.end() && it->userId == userId) ? &*it : nullptr;
+}
+
+// The loops below are branch-free sums over flat arrays so they vectorise at -O2/-O3
+
+size_t TaskColumns::countCompleted(size_t begin, size_t end) const
+{
+    const uint8_t* s = status.data();
+    size_t count = 0;
+    for (size_t i = begin; i < end; i++)
+    {
+        count += (s[i] == COLUMN_STATUS_COMPLETED);
+    }
+    return count;
+}
+
+size_t TaskColumns::countOverdue(size_t begin, size_t end, uint32_t today) const
+{
+    const uint8_t* s = status.data();
+    const uint32_t* d = dueDate.data();
+    size_t count = 0;
+    for (size_t i = begin; i < end; i++)
+    {
+        count += (s[i] == COLUMN_STATUS_ONGOING) & (d[i] != 0) & (d[i] < today);
+    }
+    return count;
+}
+
+size_t TaskColumns::countDueBetween(size_t begin, size_t end, uint32_t from, uint32_t to) const
+{
+    const uint8_t* s = status.data();
+    const uint32_t* d = dueDate.data();
+    size_t count = 0;
+    for (size_t i = begin; i < end; i++)
+    {
+        count += (s[i] == COLUMN_STATUS_ONGOING) & (d[i] >= from) & (d[i] <= to);
+    }
+    return count;
+}
@@ -0,0 +1,56 @@
+#ifndef TASK_COLUMNS_H
+#define TASK_COLUMNS_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+using namespace std;
+
+class UserManager;
+
+// Status codes stored in TaskColumns::status
+const uint8_t COLUMN_STATUS_ONGOING = 0;
+const uint8_t COLUMN_STATUS_COMPLETED = 1;
+
+// Optional column-oriented (struct-of-arrays) copy of every task for admin-wide scans.
+// Rows are grouped by owner in user ID order, so one user's tasks are the index
+// range [begin, end). Aggregates walk one or two flat arrays instead of chasing
+// hash map nodes, which lets the compiler vectorise them.
+class TaskColumns {
+public:
+    struct UserRange {
+        int userId;
+        bool isActive;
+        uint32_t begin;
+        uint32_t end;
+    };
+
+    vector<int32_t> taskId;
+    vector<int32_t> ownerId;
+    vector<uint32_t> dueDate;       // Packed YYYYMMDD (see dateutil.h)
+    vector<uint8_t> status;         // COLUMN_STATUS_*
+    vector<uint32_t> titleOffset;   // size() + 1 entries into titlePool
+    string titlePool;
+    vector<UserRange> users;        // Sorted by userId
+
+    // Rebuild from the current UserManager contents - O(users + tasks).
+    // The caller keeps writers out meanwhile (UserManager::lockAll).
+    void build(const UserManager& um);
+    void clear();
+
+    size_t size() const { return taskId.size(); }
+    string_view title(size_t row) const;
+    const UserRange* findUser(int userId) const;   // O(log users)
+
+    // Aggregate scans over [begin, end) rows
+    size_t countCompleted(size_t begin, size_t end) const;
+    size_t countOverdue(size_t begin, size_t end, uint32_t today) const;
+    size_t countDueBetween(size_t begin, size_t end, uint32_t from, uint32_t to) const;   // Ongoing only
+
+    size_t countCompleted() const { return countCompleted(0, size()); }
+    size_t countOverdue(uint32_t today) const { return countOverdue(0, size(), today); }
+    size_t countDueBetween(uint32_t from, uint32_t to) const { return countDueBetween(0, size(), from, to); }
+};
+
+#endif
@@ -0,0 +1,75 @@
+#include "taskowners.h"
+
+TaskOwnerIndex::TaskOwnerIndex()
+    : directory(new atomic<atomic<int>*>[CHUNKS]()), chunksMade(0), count(0), highest(FIRST_ID - 1)
+{
+}
+
+TaskOwnerIndex::~TaskOwnerIndex()
+{
+    for (size_t i = 0; i < CHUNKS; i++)
+    {
+        delete[] directory[i].load(memory_order_relaxed);
+    }
+}
+
+atomic<int>* TaskOwnerIndex::find(int taskId) const
+{
+    if (taskId < FIRST_ID) return nullptr;
+    size_t offset = static_cast<size_t>(taskId) - FIRST_ID;
+    atomic<int>* chunk = directory[offset >> CHUNK_BITS].load(memory_order_acquire);
+    return chunk ? &chunk[offset & (CHUNK_SIZE - 1)] : nullptr;
+}
+
+// Two threads may race to make the same chunk - the loser frees its copy
+atomic<int>* TaskOwnerIndex::make(int taskId)
+{
+    if (taskId < FIRST_ID) return nullptr;
+    size_t offset = static_cast<size_t>(taskId) - FIRST_ID;
+    atomic<atomic<int>*>& entry = directory[offset >> CHUNK_BITS];
+
+    atomic<int>* chunk = entry.load(memory_order_acquire);
+    if (!chunk)
+    {
+        atomic<int>* made = new atomic<int>[CHUNK_SIZE]();
+        if (entry.compare_exchange_strong(chunk, made, memory_order_acq_rel))
+        {
+            chunk = made;
+            chunksMade++;
+        }
+        else
+        {
+            delete[] made;
+        }
+    }
+    return &chunk[offset & (CHUNK_SIZE - 1)];
+}
+
+void TaskOwnerIndex::add(int taskId, int userId)
+{
+    atomic<int>* entry = make(taskId);
+    if (!entry) return;
+    if (entry->exchange(userId, memory_order_relaxed) == 0) count++;
+
+    int top = highest.load(memory_order_relaxed);
+    while (taskId > top && !highest.compare_exchange_weak(top, taskId, memory_order_relaxed))
+    {
+    }
+}
+
+void TaskOwnerIndex::remove(int taskId, int userId)
+{
+    atomic<int>* entry = find(taskId);
+    if (entry && entry->compare_exchange_strong(userId, 0, memory_order_relaxed)) count--;
+}
+
+int TaskOwnerIndex::owner(int taskId) const
+{
+    atomic<int>* entry = find(taskId);
+    return entry ? entry->load(memory_order_relaxed) : 0;
+}
+
+size_t TaskOwnerIndex::memoryBytes() const
+{
+    return CHUNKS * sizeof(directory[0]) + chunksMade.load(memory_order_relaxed) * CHUNK_SIZE * sizeof(atomic<int>);
+}
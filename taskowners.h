@@ -0,0 +1,52 @@
+#ifndef TASK_OWNERS_H
+#define TASK_OWNERS_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+using namespace std;
+
+// Task ID -> owning user ID for every task. Task IDs come from one global
+// counter starting at 1001, so the index is a dense array offset from there:
+// a lookup is a subtraction and a load. The array is cut into fixed chunks
+// reached through a directory sized for every int task ID; a chunk is made on
+// first use and never moves, and the entries are atomics, so task operations
+// holding different shard locks update it side by side and readers never lock.
+// IDs below 1001 (only possible in hand-edited data files) are not indexed.
+class TaskOwnerIndex {
+public:
+    static const int FIRST_ID = 1001;
+
+    TaskOwnerIndex();
+    ~TaskOwnerIndex();
+
+    TaskOwnerIndex(const TaskOwnerIndex&) = delete;
+    TaskOwnerIndex& operator=(const TaskOwnerIndex&) = delete;
+
+    void add(int taskId, int userId);
+    void remove(int taskId, int userId);     // Only if userId still owns it
+    int owner(int taskId) const;             // 0 when no user has the task
+    bool covers(int taskId) const { return taskId >= FIRST_ID; }
+
+    // Highest task ID ever added, FIRST_ID - 1 before the first - the next
+    // free ID after a load without a pass over the tasks
+    int highestTaskId() const { return highest.load(memory_order_relaxed); }
+
+    size_t size() const { return count.load(memory_order_relaxed); }
+    size_t memoryBytes() const;
+
+private:
+    static const int CHUNK_BITS = 16;                        // 65536 IDs, 256 KB per chunk
+    static const size_t CHUNK_SIZE = size_t(1) << CHUNK_BITS;
+    static const size_t CHUNKS = size_t(1) << (31 - CHUNK_BITS);   // Every ID up to INT_MAX
+
+    unique_ptr<atomic<atomic<int>*>[]> directory;
+    atomic<size_t> chunksMade;
+    atomic<size_t> count;
+    atomic<int> highest;
+
+    atomic<int>* find(int taskId) const;
+    atomic<int>* make(int taskId);                           // find, making the chunk when missing
+};
+
+#endif
@@ -0,0 +1,260 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "terminal.h"
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <io.h>
+#include <windows.h>
+#ifndef ENABLE_VIRTUAL_TERMINAL_PROCESSING
+#define ENABLE_VIRTUAL_TERMINAL_PROCESSING 0x0004
+#endif
+#else
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+const char CLEAR_SCREEN[] = "\x1b[H\x1b[2J";     // Cursor home, erase display
+const char CLEAR_LINE_END[] = "\x1b[K";
+const char CLEAR_BELOW[] = "\x1b[J";
+const size_t MAX_PENDING = 1 << 20;              // Very long listings are written in parts
+
+// True when standard output is a console that understands ANSI sequences
+// (Windows 10 consoles once VT processing is switched on)
+bool enableAnsiOutput()
+{
+#ifdef _WIN32
+    HANDLE console = GetStdHandle(STD_OUTPUT_HANDLE);
+    DWORD mode = 0;
+    if (!GetConsoleMode(console, &mode)) return false;
+    return SetConsoleMode(console, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING) != 0;
+#else
+    const char* term = getenv("TERM");
+    return isatty(STDOUT_FILENO) && term && strcmp(term, "dumb") != 0;
+#endif
+}
+
+bool inputIsConsole()
+{
+#ifdef _WIN32
+    return _isatty(_fileno(stdin)) != 0;
+#else
+    return isatty(STDIN_FILENO) != 0;
+#endif
+}
+
+void moveTo(string& out, size_t row, size_t column)
+{
+    out += "\x1b[";
+    out += to_string(row);
+    out += ';';
+    out += to_string(column);
+    out += 'H';
+}
+}
+
+Terminal::Terminal(istream& input, ostream& output)
+    : in(input), out(output), outputBuffer(*this), inputBuffer(*this), tieBuffer(*this), tieStream(&tieBuffer)
+{
+    bool console = &input == &cin && &output == &cout;
+    ansiEnabled = console && enableAnsiOutput();
+    inputEcho = console && inputIsConsole();
+    querySize();
+
+    device = out.rdbuf(&outputBuffer);
+    source = in.rdbuf(&inputBuffer);
+    errorTie = cerr.tie();
+    if (errorTie == &out) cerr.tie(&tieStream);
+}
+
+Terminal::~Terminal()
+{
+    flush();
+    if (cerr.tie() == &tieStream) cerr.tie(errorTie);
+    out.rdbuf(device);
+    in.rdbuf(source);
+}
+
+void Terminal::setAnsi(bool enabled)
+{
+    ansiEnabled = enabled;
+    positionKnown = false;
+    frameLines.clear();
+}
+
+void Terminal::setSize(int rowCount, int columnCount)
+{
+    fixedSize = true;
+    rows = rowCount;
+    columns = columnCount;
+}
+
+void Terminal::querySize()
+{
+    if (fixedSize) return;
+#ifdef _WIN32
+    CONSOLE_SCREEN_BUFFER_INFO info;
+    if (GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &info))
+    {
+        rows = info.srWindow.Bottom - info.srWindow.Top + 1;
+        columns = info.srWindow.Right - info.srWindow.Left + 1;
+    }
+#else
+    winsize size;
+    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) == 0 && size.ws_row > 0 && size.ws_col > 0)
+    {
+        rows = size.ws_row;
+        columns = size.ws_col;
+    }
+#endif
+}
+
+void Terminal::clear()
+{
+    if (!ansiEnabled) return;
+    pending += CLEAR_SCREEN;
+    positionKnown = true;
+    cursorRow = 0;
+    cursorColumn = 0;
+    frameLines.clear();
+}
+
+void Terminal::present(const string& frame)
+{
+    if (!ansiEnabled)
+    {
+        append(frame.data(), frame.size());
+        return;
+    }
+    querySize();
+
+    vector<string> lines;
+    for (size_t start = 0;;)
+    {
+        size_t end = frame.find('\n', start);
+        lines.emplace_back(frame, start, end == string::npos ? string::npos : end - start);
+        if (end == string::npos) break;
+        start = end + 1;
+    }
+
+    // Diff only against a frame still on screen, with room below it for the new one
+    size_t top = static_cast<size_t>(frameTop);
+    if (frameLines.empty() || top + lines.size() > static_cast<size_t>(rows))
+    {
+        redraw(lines, frame);
+        return;
+    }
+
+    for (size_t i = 0; i < lines.size(); i++)
+    {
+        // The old last line also holds the prompt's typed answer - always rewritten
+        if (i + 1 < frameLines.size() && lines[i] == frameLines[i]) continue;
+        moveTo(pending, top + i + 1, 1);
+        pending += lines[i];
+        pending += CLEAR_LINE_END;
+    }
+    moveTo(pending, top + lines.size() + 1, 1);
+    pending += CLEAR_BELOW;                      // Old frame lines and output below the new frame
+    moveTo(pending, top + lines.size(), lines.back().size() + 1);
+
+    cursorRow = frameTop + static_cast<int>(lines.size()) - 1;
+    cursorColumn = static_cast<int>(lines.back().size());
+    frameLines = move(lines);
+}
+
+// Print the whole frame at the cursor like any other text - on a cleared
+// screen first when the cursor position is not known yet
+void Terminal::redraw(vector<string>& lines, const string& frame)
+{
+    if (!positionKnown) clear();
+    frameLines = move(lines);
+    frameTop = cursorRow;
+    append(frame.data(), frame.size());          // Scrolling moves frameTop up, or drops the frame
+}
+
+void Terminal::flush()
+{
+    if (pending.empty()) return;
+    device->sputn(pending.data(), static_cast<streamsize>(pending.size()));
+    device->pubsync();
+    writes++;
+    bytes += pending.size();
+    pending.clear();
+}
+
+void Terminal::append(const char* s, size_t n)
+{
+    pending.append(s, n);
+    if (positionKnown) advance(s, n);
+    if (pending.size() >= MAX_PENDING) flush();
+}
+
+void Terminal::advance(const char* s, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        if (s[i] == '\n')
+        {
+            newLine();
+        }
+        else if (s[i] == '\r')
+        {
+            cursorColumn = 0;
+        }
+        else if (++cursorColumn > columns)
+        {
+            newLine();
+            cursorColumn = 1;
+        }
+    }
+}
+
+// A line feed on the bottom row scrolls everything up one row
+void Terminal::newLine()
+{
+    cursorColumn = 0;
+    if (cursorRow + 1 < rows)
+    {
+        cursorRow++;
+    }
+    else if (--frameTop < 0)
+    {
+        frameLines.clear();
+    }
+}
+
+Terminal::OutputBuffer::int_type Terminal::OutputBuffer::overflow(int_type ch)
+{
+    if (traits_type::eq_int_type(ch, traits_type::eof())) return traits_type::not_eof(ch);
+    char c = traits_type::to_char_type(ch);
+    term.append(&c, 1);
+    return ch;
+}
+
+streamsize Terminal::OutputBuffer::xsputn(const char* s, streamsize n)
+{
+    term.append(s, static_cast<size_t>(n));
+    return n;
+}
+
+int Terminal::TieBuffer::sync()
+{
+    term.flush();
+    return 0;
+}
+
+// One character at a time, so reading never blocks on more than the user typed
+Terminal::InputBuffer::int_type Terminal::InputBuffer::underflow()
+{
+    term.flush();
+    int_type ch = term.source->sbumpc();
+    if (traits_type::eq_int_type(ch, traits_type::eof())) return ch;
+
+    current = traits_type::to_char_type(ch);
+    setg(&current, &current, &current + 1);
+    if (current == '\n' && term.inputEcho && term.positionKnown) term.newLine();
+    return ch;
+}
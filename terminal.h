@@ -0,0 +1,115 @@
+#ifndef TERMINAL_H
+#define TERMINAL_H
+
+#include <cstddef>
+#include <iostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+using namespace std;
+
+// In-process console screen for the interactive menus, in place of system("cls").
+//
+// While attached, the terminal owns the buffers of the given streams:
+// console output is held back until the program reads input, so everything
+// a screen prints reaches the device in one write. clear() empties the screen
+// with ANSI escape sequences. present() prints a menu frame; when the previous
+// frame is still on screen it rewrites only the lines that differ, in place,
+// and erases whatever was printed below it. The terminal follows the cursor
+// through the output and typed lines to know where the frame is and whether it
+// has scrolled away. Without an ANSI terminal - output redirected, or a console
+// that refuses VT mode - clear() does nothing and frames are printed as text.
+class Terminal {
+public:
+    explicit Terminal(istream& in = cin, ostream& out = cout);
+    ~Terminal();                                 // Flushes and detaches
+
+    Terminal(const Terminal&) = delete;
+    Terminal& operator=(const Terminal&) = delete;
+
+    void clear();
+    void present(const string& frame);           // Lines split at '\n'; the last one may be a prompt
+    void flush();                                // Write the held-back output now
+
+    // Detected when constructed; forced by tests and benchmarks
+    bool ansi() const { return ansiEnabled; }
+    void setAnsi(bool enabled);
+    void setSize(int rows, int columns);         // Fixed size instead of querying the console
+    void setInputEcho(bool echo) { inputEcho = echo; }  // Typed lines move the cursor down
+
+    size_t writeCount() const { return writes; }     // Writes to the device so far
+    size_t bytesWritten() const { return bytes; }
+
+private:
+    // Replaces the output stream's buffer: collects instead of writing, and
+    // endl's flush does not write on its own
+    class OutputBuffer : public streambuf {
+    public:
+        explicit OutputBuffer(Terminal& t) : term(t) {}
+    protected:
+        int_type overflow(int_type ch) override;
+        streamsize xsputn(const char* s, streamsize n) override;
+        int sync() override { return 0; }
+    private:
+        Terminal& term;
+    };
+
+    // Buffer of the stream cerr is tied to while attached: the tie's flush
+    // before every cerr write sends the held-back output first, so the two
+    // reach the device in the order they were written
+    class TieBuffer : public streambuf {
+    public:
+        explicit TieBuffer(Terminal& t) : term(t) {}
+    protected:
+        int sync() override;
+    private:
+        Terminal& term;
+    };
+
+    // Replaces the input stream's buffer: writes the pending output before
+    // reading, and counts the lines typed for the cursor position
+    class InputBuffer : public streambuf {
+    public:
+        explicit InputBuffer(Terminal& t) : term(t) {}
+    protected:
+        int_type underflow() override;
+    private:
+        Terminal& term;
+        char current = 0;
+    };
+
+    istream& in;
+    ostream& out;
+    streambuf* device;                  // out's own buffer, the real console
+    streambuf* source;                  // in's own buffer
+    OutputBuffer outputBuffer;
+    InputBuffer inputBuffer;
+    TieBuffer tieBuffer;
+    ostream tieStream;                  // cerr's tie instead of out
+    ostream* errorTie;                  // cerr's tie before attaching
+
+    string pending;                     // Output not yet written
+    bool ansiEnabled;
+    bool inputEcho;
+    bool fixedSize = false;
+    int rows = 24;
+    int columns = 80;
+
+    // Cursor position, known from the first clear on
+    bool positionKnown = false;
+    int cursorRow = 0;
+    int cursorColumn = 0;
+    vector<string> frameLines;          // Frame on screen; empty after a clear or once scrolled off
+    int frameTop = 0;                   // Screen row of its first line
+
+    size_t writes = 0;
+    size_t bytes = 0;
+
+    void append(const char* s, size_t n);        // Console text: buffered, cursor tracked
+    void advance(const char* s, size_t n);
+    void newLine();
+    void querySize();
+    void redraw(vector<string>& lines, const string& frame);
+};
+
+#endif
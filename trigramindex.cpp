@@ -0,0 +1,109 @@
+#include <algorithm>
+#include "trigramindex.h"
+
+namespace
+{
+uint32_t trigramAt(const string& text, size_t i)
+{
+    return static_cast<uint32_t>(static_cast<unsigned char>(text[i])) << 16 |
+           static_cast<uint32_t>(static_cast<unsigned char>(text[i + 1])) << 8 |
+           static_cast<uint32_t>(static_cast<unsigned char>(text[i + 2]));
+}
+}
+
+void TrigramIndex::distinctTrigrams(const string& text, vector<uint32_t>& out)
+{
+    out.clear();
+    if (text.size() < MIN_QUERY_LENGTH) return;
+
+    out.reserve(text.size() - 2);
+    for (size_t i = 0; i + 2 < text.size(); i++)
+    {
+        out.push_back(trigramAt(text, i));
+    }
+    sort(out.begin(), out.end());
+    out.erase(unique(out.begin(), out.end()), out.end());
+}
+
+void TrigramIndex::add(int id, const string& text)
+{
+    distinctTrigrams(text, scratch);
+    for (uint32_t gram : scratch)
+    {
+        vector<int>& ids = postings[gram];
+        // IDs are handed out in increasing order, so this is almost always an append
+        if (ids.empty() || ids.back() < id)
+        {
+            ids.push_back(id);
+        }
+        else
+        {
+            auto it = lower_bound(ids.begin(), ids.end(), id);
+            if (it == ids.end() || *it != id) ids.insert(it, id);
+        }
+    }
+}
+
+void TrigramIndex::remove(int id, const string& text)
+{
+    distinctTrigrams(text, scratch);
+    for (uint32_t gram : scratch)
+    {
+        auto found = postings.find(gram);
+        if (found == postings.end()) continue;
+
+        vector<int>& ids = found->second;
+        auto it = lower_bound(ids.begin(), ids.end(), id);
+        if (it != ids.end() && *it == id) ids.erase(it);
+        if (ids.empty()) postings.erase(found);
+    }
+}
+
+vector<int> TrigramIndex::candidates(const string& keyword) const
+{
+    vector<int> result;
+    vector<uint32_t> grams;
+    distinctTrigrams(keyword, grams);
+    if (grams.empty()) return result;
+
+    // Shortest posting list first; a missing trigram means no match at all
+    vector<const vector<int>*> lists;
+    lists.reserve(grams.size());
+    for (uint32_t gram : grams)
+    {
+        auto found = postings.find(gram);
+        if (found == postings.end()) return result;
+        lists.push_back(&found->second);
+    }
+    sort(lists.begin(), lists.end(), [](const vector<int>* a, const vector<int>* b)
+    {
+        return a->size() < b->size();
+    });
+
+    // Each survivor is searched for in the longer lists with a moving lower bound
+    result = *lists[0];
+    for (size_t l = 1; l < lists.size() && !result.empty(); l++)
+    {
+        const vector<int>& other = *lists[l];
+        auto from = other.begin();
+        size_t kept = 0;
+        for (int id : result)
+        {
+            from = lower_bound(from, other.end(), id);
+            if (from == other.end()) break;
+            if (*from == id) result[kept++] = id;
+        }
+        result.resize(kept);
+    }
+    return result;
+}
+
+size_t TrigramIndex::postingCount() const
+{
+    size_t total = 0;
+    for (const auto& pair : postings)
+    {
+        total += pair.second.size();
+    }
+    return total;
+}
@@ -0,0 +1,38 @@
+#ifndef TRIGRAM_INDEX_H
+#define TRIGRAM_INDEX_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+using namespace std;
+
+// Inverted index from every 3-byte substring (trigram) to the sorted IDs whose
+// text contains it. A substring query of length >= 3 intersects the posting
+// lists of its trigrams, starting from the shortest, so the work follows the
+// rarest trigram rather than the number of indexed IDs. Candidates can be
+// false positives (all trigrams present but not adjacent) - callers verify.
+class TrigramIndex {
+private:
+    unordered_map<uint32_t, vector<int>> postings;   // trigram -> sorted IDs
+    vector<uint32_t> scratch;                        // Trigrams of the text being added or removed
+
+    static void distinctTrigrams(const string& text, vector<uint32_t>& out);
+
+public:
+    static const size_t MIN_QUERY_LENGTH = 3;
+
+    // Index / unindex the text of one ID - O(trigrams * log postings)
+    void add(int id, const string& text);
+    void remove(int id, const string& text);
+    void clear() { postings.clear(); }
+
+    // IDs whose text contains every trigram of keyword, ascending.
+    // keyword must be at least MIN_QUERY_LENGTH bytes long.
+    vector<int> candidates(const string& keyword) const;
+
+    size_t trigramCount() const { return postings.size(); }
+    size_t postingCount() const;
+};
+
+#endif
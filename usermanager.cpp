@@ -1,15 +1,32 @@
-#include <iomanip>
 #include <limits>
 #include <fstream>
 #include <sstream>
 #include <algorithm>
+#include <iterator>
 #include "usermanager.h"
+#include "dateutil.h"
+#include "journal.h"
+#include "reminders.h"
+#include "taskcolumns.h"
+#include "tablerenderer.h"
+#include "terminal.h"
 
 // Initialize UserManager with hash tables and sample data
-UserManager::UserManager()
+UserManager::UserManager(unsigned shardCount)
 {
+    shards.resize(max(1u, shardCount));
+    for (auto& shard : shards)
+    {
+        shard.reset(new UserShard(static_cast<unsigned>(shards.size())));
+    }
+
+    currentView = make_shared<AdminView>();
+    journal = nullptr;
+    terminal = nullptr;
+    reminders = nullptr;
     userIdCounter = 101;
     taskIdCounter = 1001;
+    userCount = 0;
     activeUsersCount = 0;
     totalTasksCount = 0;
     completedTasksCount = 0;
@@ -20,18 +37,6 @@ UserManager::UserManager()
     addUser("Himel", "Himel@gmail.com", "abcd");
     addUser("Anam", "Anamul@gmail.com", "ab1234");
     addUser("Tayeen", "tayeen@gmail.com", "ab234");
-
-    // Update task counter to avoid conflicts with any existing tasks
-    for (const auto& userPair : usersById)
-    {
-        for (const auto& taskPair : userPair.second.tasks)
-        {
-            if (taskPair.first >= taskIdCounter)
-            {
-                taskIdCounter = taskPair.first + 1;
-            }
-        }
-    }
 }
 
 // Destructor - Hash tables handle cleanup automatically
@@ -40,66 +45,193 @@ UserManager::~UserManager()
 
 }
 
-// Update statistics counters - O(1) dashboard operations
-void UserManager::updateStatistics()
+#ifndef NDEBUG
+// Debug consistency check - recount every user and task and compare with the O(1) counters
+bool UserManager::statisticsConsistent() const
 {
-    activeUsersCount = 0;
-    totalTasksCount = 0;
-    completedTasksCount = 0;
+    int users = 0, active = 0, total = 0, completed = 0;
+    size_t dueEntries = 0;
+    bool perUserOk = true;
+
+    size_t slotUsers = 0;
+    for (const auto& shard : shards)
+    {
+        dueEntries += shard->dueIndex.size();
+        slotUsers += shard->users.size();
+    }
 
-    for (auto& pair : usersById)
+    forEachUser([&](const User& user)
     {
-        if (pair.second.isActive)
+        users++;
+        if (user.isActive)
         {
-            activeUsersCount++;
+            active++;
         }
 
-        for (auto& taskPair : pair.second.tasks)
+        int userCompleted = 0;
+        for (const auto& taskPair : user.tasks)
         {
-            totalTasksCount++;
+            total++;
             if (taskPair.second.status == "Completed")
             {
-                completedTasksCount++;
+                userCompleted++;
+            }
+            if (taskOwners.covers(taskPair.first) && taskOwners.owner(taskPair.first) != user.id)
+            {
+                perUserOk = false;
             }
         }
+        completed += userCompleted;
+        if (userCompleted != user.completedCount || user.dueIndex.size() != user.tasks.size())
+        {
+            perUserOk = false;
+        }
+    });
+
+    if (users != userCount || active != activeUsersCount || total != totalTasksCount ||
+            completed != completedTasksCount || static_cast<int>(dueEntries) != total ||
+            static_cast<int>(slotUsers) != users || !perUserOk)
+    {
+        cerr << "Statistics mismatch: users " << userCount << "/" << users
+             << ", active " << activeUsersCount << "/" << active
+             << ", tasks " << totalTasksCount << "/" << total
+             << ", completed " << completedTasksCount << "/" << completed
+             << ", due index " << dueEntries
+             << ", slots used " << slotUsers
+             << (perUserOk ? "" : ", per-user counts or task owners differ") << endl;
+        return false;
+    }
+    return true;
+}
+#endif
+
+// Add (sign = 1) or remove (sign = -1) one task's contribution to the counters
+// and the due-date indexes - O(log n), caller holds the user's shard lock
+void UserManager::trackTask(User* user, const Task& task, int sign)
+{
+    DueIndex& dueIndex = shardFor(user->id).dueIndex;
+    bool completed = task.status == "Completed";
+    totalTasksCount += sign;
+    if (completed)
+    {
+        completedTasksCount += sign;
+        user->completedCount += sign;
+    }
+
+    DueEntry entry = { completed, task.dueDate, task.taskId, user->id };
+    if (sign > 0)
+    {
+        dueIndex.insert(entry);
+        user->dueIndex.insert(entry);
+    }
+    else
+    {
+        dueIndex.erase(entry);
+        user->dueIndex.erase(entry);
+    }
+    markViewDirty(user);
+}
+
+// O(1) - remember the user once per view version
+void UserManager::markViewDirty(User* user)
+{
+    if (!user->viewDirty)
+    {
+        user->viewDirty = true;
+        shardFor(user->id).dirtyUsers.push_back(user->id);
+    }
+}
+
+// O(1) - completed and undated tasks have nothing left to remind of
+void UserManager::remindTask(int userId, const Task& task)
+{
+    if (!reminders) return;
+    if (task.status == "Completed" || task.dueDate == 0)
+    {
+        reminders->cancel(task.taskId);
+    }
+    else
+    {
+        reminders->schedule(userId, task.taskId, task.dueDate);
     }
 }
 
 // O(1) user lookup by ID
 User* UserManager::findUserById(int id)
 {
-    auto it = usersById.find(id);
-    return (it != usersById.end()) ? &it->second : nullptr;
+    return shardFor(id).users.find(id);
 }
 
-// O(1) user lookup by username
-User* UserManager::findUserByUsername(const string& username)
+// Console screen for the menus - nothing to clear without an attached terminal
+void UserManager::clearScreen()
+{
+    if (terminal) terminal->clear();
+}
+
+// Menu text drawn from the top of the screen, redrawing only what changed
+void UserManager::showMenu(const string& frame)
 {
-    auto it = usersByUsername.find(username);
-    if (it != usersByUsername.end())
+    if (terminal)
     {
-        return findUserById(it->second);
+        terminal->present(frame);
     }
-    return nullptr;
+    else
+    {
+        cout << frame;
+    }
+}
+
+// Take identityLock and every shard lock in the fixed order - stops all writers
+vector<unique_lock<mutex>> UserManager::lockAll() const
+{
+    vector<unique_lock<mutex>> locks;
+    locks.reserve(shards.size() + 1);
+    locks.emplace_back(identityLock);
+    for (const auto& shard : shards)
+    {
+        locks.emplace_back(shard->lock);
+    }
+    return locks;
+}
+
+// Size the shards and indexes once before a bulk load
+void UserManager::reserveUsers(size_t count)
+{
+    int maxId = static_cast<int>(min<size_t>(static_cast<size_t>(userIdCounter) + count, INT_MAX));
+    for (auto& shard : shards)
+    {
+        shard->users.reserve(maxId);
+    }
+    identities.reserve(identities.size() + count);
+}
+
+// O(1) user lookup by username
+User* UserManager::findUserByUsername(const string& username)
+{
+    int id = identities.findUsername(username);
+    return id ? findUserById(id) : nullptr;
 }
 
 // O(1) username uniqueness check
 bool UserManager::isUsernameUnique(const string& username)
 {
-    return usedUsernames.find(username) == usedUsernames.end();
+    OP_TIMER(Op::IsUsernameUnique);
+    lock_guard<mutex> guard(identityLock);
+    return identities.findUsername(username) == 0;
 }
 
 // O(1) email uniqueness check
 bool UserManager::isEmailUnique(const string& email)
 {
-    return usedEmails.find(email) == usedEmails.end();
+    OP_TIMER(Op::IsEmailUnique);
+    lock_guard<mutex> guard(identityLock);
+    return identities.findEmail(email) == 0;
 }
 
 // O(1) user authentication
 bool UserManager::authenticateUser(const string& username, const string& password)
 {
-    User* user = findUserByUsername(username);
-    return (user && user->password == password && user->isActive);
+    return loginUser(username, password) == OpStatus::Ok;
 }
 
 // Get next unique task ID
@@ -128,31 +260,34 @@ bool UserManager::isValidEmail(const string& email)
     return true;
 }
 
+// Field checks of a new account - no uniqueness, no lock
+OpStatus UserManager::validateNewUser(const string& username, const string& email, const string& password)
+{
+    if (username.empty()) return OpStatus::InvalidUsername;
+    if (password.length() < 3) return OpStatus::InvalidPassword;
+    if (email.empty() || !isValidEmail(email)) return OpStatus::InvalidEmail;
+    return OpStatus::Ok;
+}
+
 // Date validation for DD/MM/YYYY format
 bool UserManager::isValidDate(const string& date)
 {
-    if (date.length() != 10) return false;
-    if (date[2] != '/' || date[5] != '/') return false;
-
-    for (int i = 0; i < 10; i++)
-    {
-        if (i == 2 || i == 5) continue;
-        if (date[i] < '0' || date[i] > '9') return false;
-    }
-
-    string dayStr = date.substr(0, 2);
-    string monthStr = date.substr(3, 2);
-    string yearStr = date.substr(6, 4);
+    return parseDueDate(date) != 0;
+}
 
-    int day = stoi(dayStr);
-    int month = stoi(monthStr);
-    int year = stoi(yearStr);
+// Parse and validate a DD/MM/YYYY date once, returning it packed as YYYYMMDD
+uint32_t UserManager::parseDueDate(const string& date)
+{
+    uint32_t packed = packDate(date);
+    uint32_t day = packed % 100;
+    uint32_t month = packed / 100 % 100;
+    uint32_t year = packed / 10000;
 
-    if (day < 1 || day > 31) return false;
-    if (month < 1 || month > 12) return false;
-    if (year < 2024 || year > 2030) return false;
+    if (day < 1 || day > 31) return 0;
+    if (month < 1 || month > 12) return 0;
+    if (year < 2024 || year > 2030) return 0;
 
-    return true;
+    return packed;
 }
 
 // Admin login with hardcoded credentials
@@ -166,7 +301,7 @@ bool UserManager::adminLogin()
 
     if (uname == "admin" && pass == "123")
     {
-        system("cls");
+        clearScreen();
         return true;
     }
     return false;
@@ -175,32 +310,51 @@ bool UserManager::adminLogin()
 // O(1) Dashboard statistics display using counters
 void UserManager::showAdminDashboard()
 {
-    updateStatistics(); // Update counters
+    // All figures from one view version, so they agree with each other
+    shared_ptr<const AdminView> view = adminView();
+    int totalUsers = static_cast<int>(view->users.size());
 
     cout << "\n------- Admin Dashboard Stats ---------\n" << endl;
-    cout << "Total Users: " << getTotalUsersCount() << endl;
-    cout << "Active Users: " << getActiveUsersCount() << endl;
-    cout << "Inactive Users: " << (getTotalUsersCount() - getActiveUsersCount()) << endl;
-    cout << "Total Tasks: " << getTotalTasksCount() << endl;
-    cout << "Ongoing Tasks: " << (getTotalTasksCount() - getCompletedTasksCount()) << endl;
-    cout << "Completed Tasks: " << getCompletedTasksCount() << endl;
+    cout << "Total Users: " << totalUsers << endl;
+    cout << "Active Users: " << view->activeUsers << endl;
+    cout << "Inactive Users: " << (totalUsers - view->activeUsers) << endl;
+    cout << "Total Tasks: " << view->totalTasks << endl;
+    cout << "Ongoing Tasks: " << (view->totalTasks - view->completedTasks) << endl;
+    cout << "Completed Tasks: " << view->completedTasks << endl;
     cout << "\n---------------------------------------\n";
 }
 
+// Admin Performance view - latency per operation since startup
+void UserManager::showPerformance()
+{
+    cout << "\n------- Performance -------\n" << endl;
+#ifndef TASK_PLANNER_NO_METRICS
+    opMetrics.writeReport(cout);
+#else
+    cout << "Metrics are not part of this build (TASK_PLANNER_NO_METRICS).\n";
+#endif
+    cout << "\n---------------------------\n";
+}
+
 // Admin dashboard menu with hash table optimized operations
 void UserManager::adminDashboardMenu()
 {
     int choice;
     do
     {
-        cout << "\n------- Admin Options -------\n";
-        cout << "1. Search User\n";
-        cout << "2. View All Users\n";
-        cout << "3. Filter Users\n";
-        cout << "4. View All Users Task\n";
-        cout << "5. Activate/Deactivate Account\n";
-        cout << "6. Back to Main Menu\n";
-        cout << "Enter your choice: ";
+        showMenu("\n------- Admin Options -------\n"
+                 "1. Search User\n"
+                 "2. View All Users\n"
+                 "3. Filter Users\n"
+                 "4. View All Users Task\n"
+                 "5. Activate/Deactivate Account\n"
+                 "6. Task Analytics\n"
+                 "7. Performance\n"
+                 "8. Import Users (CSV)\n"
+                 "9. Bulk Task Actions\n"
+                 "10. Find Task by ID\n"
+                 "11. Back to Main Menu\n"
+                 "Enter your choice: ");
 
         if (!(cin >> choice))
         {
@@ -215,7 +369,7 @@ void UserManager::adminDashboardMenu()
         {
         case 1:
         {
-            system("cls");
+            clearScreen();
             cout << "\n--- Search Users ---\n";
             string keyword;
             cout << "Enter keyword (id/email/username): ";
@@ -234,7 +388,7 @@ void UserManager::adminDashboardMenu()
 
         case 2:
         {
-            system("cls");
+            clearScreen();
             cout << "\n--- All User List ---\n" << endl;
             viewAllUsers();
             break;
@@ -242,14 +396,14 @@ void UserManager::adminDashboardMenu()
 
         case 3:
         {
-            system("cls");
+            clearScreen();
             filterUsers();
             break;
         }
 
         case 4:
         {
-            system("cls");
+            clearScreen();
             cout << "\n--- View All User Tasks ---\n";
             viewAllUserTasks();
             break;
@@ -257,7 +411,7 @@ void UserManager::adminDashboardMenu()
 
         case 5:
         {
-            system("cls");
+            clearScreen();
             cout << "\n--- Toggle User Activation ---\n";
             int id;
             cout << "Enter User ID to toggle activation: ";
@@ -276,6 +430,41 @@ void UserManager::adminDashboardMenu()
         }
 
         case 6:
+        {
+            clearScreen();
+            showTaskAnalytics();
+            break;
+        }
+
+        case 7:
+        {
+            clearScreen();
+            showPerformance();
+            break;
+        }
+
+        case 8:
+        {
+            clearScreen();
+            importUsersMenu();
+            break;
+        }
+
+        case 9:
+        {
+            clearScreen();
+            bulkTaskMenu(0);
+            break;
+        }
+
+        case 10:
+        {
+            clearScreen();
+            findTaskMenu();
+            break;
+        }
+
+        case 11:
         {
             cout << "\n--- Returning to Main Menu ---\n" << endl;
             cout << "Goodbye favorite user!\n" << endl;
@@ -284,77 +473,685 @@ void UserManager::adminDashboardMenu()
 
         default:
         {
-            cout << "\nInvalid choice! Please enter a number between 1-6.\n";
+            cout << "\nInvalid choice! Please enter a number between 1-11.\n";
             break;
         }
         }
 
-        if (choice != 6)
+        if (choice != 11)
         {
             cout << "\nPress Enter to continue...";
             cin.get();
         }
 
     }
-    while (choice != 6);
+    while (choice != 11);
+}
+
+// System-wide task analytics computed over a columnar copy of all tasks
+void UserManager::showTaskAnalytics()
+{
+    TaskColumns columns;
+    {
+        auto locks = lockAll(); // Writers stopped while the rows are copied out
+        columns.build(*this);
+    }
+
+    uint32_t today = todayPacked();
+    uint32_t weekAhead = packedDateAfterDays(7);
+    size_t total = columns.size();
+    size_t completed = columns.countCompleted();
+
+    cout << "\n------- Task Analytics ---------\n" << endl;
+    cout << "Total Tasks: " << total << endl;
+    cout << "Completed: " << completed;
+    if (total > 0)
+    {
+        cout << " (" << (completed * 100 / total) << "%)";
+    }
+    cout << endl;
+    cout << "Overdue and still Ongoing: " << columns.countOverdue(today) << endl;
+    cout << "Due in the next 7 days: " << columns.countDueBetween(today, weekAhead) << endl;
+
+    // Users with the most overdue work, per-user ranges are contiguous rows
+    vector<pair<size_t, int>> overdueByUser;
+    for (const auto& range : columns.users)
+    {
+        size_t overdue = columns.countOverdue(range.begin, range.end, today);
+        if (overdue > 0)
+        {
+            overdueByUser.push_back({overdue, range.userId});
+        }
+    }
+    size_t shown = min<size_t>(overdueByUser.size(), 5);
+    partial_sort(overdueByUser.begin(), overdueByUser.begin() + shown, overdueByUser.end(),
+                 [](const pair<size_t, int>& a, const pair<size_t, int>& b)
+    {
+        return a.first > b.first || (a.first == b.first && a.second < b.second);
+    });
+
+    if (shown > 0)
+    {
+        cout << "\nMost overdue tasks:\n";
+        for (size_t i = 0; i < shown; i++)
+        {
+            const User* user = getUser(overdueByUser[i].second);
+            cout << "ID: " << overdueByUser[i].second << ", Username: " << (user ? user->username : "?")
+                 << ", Overdue: " << overdueByUser[i].first << "\n";
+        }
+    }
+    cout << "\n--------------------------------\n";
 }
 
 // O(1) user addition with multiple hash table indexing
 bool UserManager::addUser(const string& username, const string& email, const string& password)
 {
-    // Check uniqueness using O(1) hash set lookups
-    if (!isUsernameUnique(username))
+    OP_TIMER(Op::AddUser);
+    lock_guard<mutex> guard(identityLock);
+    return addUserLocked(username, email, password, nullptr);
+}
+
+// addUser body - caller holds identityLock
+bool UserManager::addUserLocked(const string& username, const string& email, const string& password, int* newUserIdOut)
+{
+    // Check uniqueness using O(1) identity index lookups
+    if (identities.findUsername(username))
     {
         return false; // Username already exists
     }
 
-    if (!isEmailUnique(email))
+    if (identities.findEmail(email))
     {
         return false; // Email already exists
     }
 
-    int newUserId = userIdCounter++;
+    // Reuse the slot of a deleted user before growing the ID range
+    int newUserId;
+    if (!freeUserIds.empty())
+    {
+        newUserId = freeUserIds.back();
+        freeUserIds.pop_back();
+    }
+    else
+    {
+        newUserId = userIdCounter++;
+    }
 
     // Create new user
     User newUser(newUserId, username, email, password, true);
 
     // Insert into all hash tables for O(1) access
-    usersById[newUserId] = newUser;
-    usersByUsername[username] = newUserId;
-    usersByEmail[email] = newUserId;
-
-    // Add to uniqueness sets
-    usedUsernames.insert(username);
-    usedEmails.insert(email);
+    UserShard& shard = shardFor(newUserId);
+    User* stored;
+    {
+        lock_guard<mutex> shardGuard(shard.lock);
+        stored = &shard.users.insert(newUserId);
+        *stored = move(newUser);
+        markViewDirty(stored);
+    }
+    userCount++;
+    activeUsersCount++;
+    identities.add(newUserId, stored->username, stored->email);
+    searchIndex.add(newUserId, searchText(*stored));
 
+    if (journal) journal->logAddUser(newUserId, username, email, password);
+    if (newUserIdOut)
+    {
+        *newUserIdOut = newUserId;
+    }
     return true;
 }
 
-// Display all users using hash table iteration
-void UserManager::viewAllUsers()
+// Message text for headless operation results
+const char* opStatusMessage(OpStatus status)
 {
-    cout << "\n--- All Users List ---\n";
-    cout << setw(5) << "ID" << setw(15) << "Username" << setw(25) << "Email" << setw(10) << "Status" << endl;
-    cout << string(55, '-') << endl;
+    switch (status)
+    {
+    case OpStatus::Ok:               return "OK";
+    case OpStatus::UserNotFound:     return "User not found.";
+    case OpStatus::TaskNotFound:     return "Task not found.";
+    case OpStatus::InvalidUsername:  return "Username cannot be empty!";
+    case OpStatus::InvalidEmail:     return "Invalid email format!";
+    case OpStatus::InvalidPassword:  return "Password must be at least 3 characters long!";
+    case OpStatus::InvalidTitle:     return "Invalid title! Title cannot be empty or too long.";
+    case OpStatus::InvalidDate:      return "Invalid date format! Please use DD/MM/YYYY format.";
+    case OpStatus::InvalidStatus:    return "Invalid status! Use Ongoing or Completed.";
+    case OpStatus::UsernameTaken:    return "Username is already taken!";
+    case OpStatus::EmailTaken:       return "Email is already registered!";
+    case OpStatus::WrongPassword:    return "Incorrect password!";
+    case OpStatus::AccountInactive:  return "Your account has been deactivated. Please contact administrator.";
+    case OpStatus::AlreadyCompleted: return "Task is already completed!";
+    case OpStatus::NoChange:         return "Nothing to change.";
+    case OpStatus::IoError:          return "File could not be read or written.";
+    case OpStatus::MalformedRow:     return "Malformed row: expected username,email,password[,status].";
+    }
+    return "Unknown error.";
+}
+
+// Read-only O(1) user lookup for callers outside the class
+const User* UserManager::getUser(int id) const
+{
+    return shardFor(id).users.find(id);
+}
+
+UserHandle UserManager::handleOf(int id) const
+{
+    const UserShard& shard = shardFor(id);
+    lock_guard<mutex> guard(shard.lock);
+    if (!shard.users.find(id)) return { id, 0 };
+    return { id, shard.users.generation(id) };
+}
 
-    vector<User> sortedUsers;
-    for (const auto& pair : usersById)
+// The slot's generation moves on when the user is deleted, so a handle from
+// before the deletion fails even when the ID has been given to someone else
+bool UserManager::isCurrent(const UserHandle& handle) const
+{
+    const UserShard& shard = shardFor(handle.id);
+    lock_guard<mutex> guard(shard.lock);
+    return shard.users.find(handle.id) && shard.users.generation(handle.id) == handle.generation;
+}
+
+// Headless registration with the same validation as userRegistration
+OpStatus UserManager::registerUser(const string& username, const string& email, const string& password, int* newUserId)
+{
+    OP_TIMER(Op::RegisterUser);
+    OpStatus valid = validateNewUser(username, email, password);
+    if (valid != OpStatus::Ok) return valid;
+
+    lock_guard<mutex> guard(identityLock);
+    if (identities.findUsername(username)) return OpStatus::UsernameTaken;
+    if (identities.findEmail(email)) return OpStatus::EmailTaken;
+
+    addUserLocked(username, email, password, newUserId);
+    return OpStatus::Ok;
+}
+
+// Headless credential check - does not apply the attempt limit
+OpStatus UserManager::loginUser(const string& username, const string& password, int* userId)
+{
+    OP_TIMER(Op::LoginUser);
+    int id;
     {
-        sortedUsers.push_back(pair.second);
+        lock_guard<mutex> guard(identityLock);
+        id = identities.findUsername(username);
+        if (!id) return OpStatus::UserNotFound;
     }
-    sort(sortedUsers.begin(), sortedUsers.end(), [](const User& a, const User& b)
+
+    UserShard& shard = shardFor(id);
+    lock_guard<mutex> guard(shard.lock);
+    User* user = findUserById(id);
+    if (!user) return OpStatus::UserNotFound;
+    if (!user->isActive) return OpStatus::AccountInactive;
+    if (user->password != password) return OpStatus::WrongPassword;
+
+    if (userId)
     {
-        return a.id < b.id;
+        *userId = user->id;
+    }
+    return OpStatus::Ok;
+}
+
+// O(1) activation change
+OpStatus UserManager::setUserActive(int id, bool active)
+{
+    OP_TIMER(Op::SetUserActive);
+    UserShard& shard = shardFor(id);
+    lock_guard<mutex> guard(shard.lock);
+    User* user = findUserById(id);
+    if (!user) return OpStatus::UserNotFound;
+
+    if (user->isActive != active)
+    {
+        activeUsersCount += active ? 1 : -1;
+    }
+    user->isActive = active;
+    markViewDirty(user);
+    if (journal) journal->logSetUserActive(id, active);
+    return OpStatus::Ok;
+}
+
+// O(1) username change keeping all indexes in sync
+OpStatus UserManager::changeUsername(int userId, const string& newUsername)
+{
+    OP_TIMER(Op::ChangeUsername);
+    // identityLock for the indexes, the shard lock so admin view rebuilds can read the name
+    lock_guard<mutex> guard(identityLock);
+    User* user = findUserById(userId);
+    if (!user) return OpStatus::UserNotFound;
+    if (newUsername.empty()) return OpStatus::InvalidUsername;
+    if (newUsername == user->username) return OpStatus::NoChange;
+    if (identities.findUsername(newUsername)) return OpStatus::UsernameTaken;
+
+    // Unindex before the viewed string changes
+    identities.remove(user->id, user->username, user->email);
+    searchIndex.remove(user->id, searchText(*user));
+
+    // Update user and index the new username
+    {
+        lock_guard<mutex> shardGuard(shardFor(userId).lock);
+        user->username = newUsername;
+        markViewDirty(user);
+    }
+    identities.add(user->id, user->username, user->email);
+    searchIndex.add(user->id, searchText(*user));
+    if (journal) journal->logChangeUsername(userId, newUsername);
+    return OpStatus::Ok;
+}
+
+// O(1) email change keeping all indexes in sync
+OpStatus UserManager::changeEmail(int userId, const string& newEmail)
+{
+    OP_TIMER(Op::ChangeEmail);
+    // identityLock for the indexes, the shard lock so admin view rebuilds can read the email
+    lock_guard<mutex> guard(identityLock);
+    User* user = findUserById(userId);
+    if (!user) return OpStatus::UserNotFound;
+    if (newEmail.empty()) return OpStatus::InvalidEmail;
+    if (newEmail == user->email) return OpStatus::NoChange;
+    if (!isValidEmail(newEmail)) return OpStatus::InvalidEmail;
+    if (identities.findEmail(newEmail)) return OpStatus::EmailTaken;
+
+    // Unindex before the viewed string changes
+    identities.remove(user->id, user->username, user->email);
+    searchIndex.remove(user->id, searchText(*user));
+
+    // Update user and index the new email
+    {
+        lock_guard<mutex> shardGuard(shardFor(userId).lock);
+        user->email = newEmail;
+        markViewDirty(user);
+    }
+    identities.add(user->id, user->username, user->email);
+    searchIndex.add(user->id, searchText(*user));
+    if (journal) journal->logChangeEmail(userId, newEmail);
+    return OpStatus::Ok;
+}
+
+// O(1) password change after verifying the current password
+OpStatus UserManager::changePassword(int userId, const string& currentPassword, const string& newPassword)
+{
+    OP_TIMER(Op::ChangePassword);
+    UserShard& shard = shardFor(userId);
+    lock_guard<mutex> guard(shard.lock);
+    User* user = findUserById(userId);
+    if (!user) return OpStatus::UserNotFound;
+    if (user->password != currentPassword) return OpStatus::WrongPassword;
+    if (newPassword.length() < 3) return OpStatus::InvalidPassword;
+
+    user->password = newPassword;
+    if (journal) journal->logChangePassword(userId, newPassword);
+    return OpStatus::Ok;
+}
+
+// Remove a user and all tasks from every hash table - O(1)
+OpStatus UserManager::removeUser(int userId)
+{
+    OP_TIMER(Op::RemoveUser);
+    lock_guard<mutex> guard(identityLock);
+    UserShard& shard = shardFor(userId);
+    lock_guard<mutex> shardGuard(shard.lock);
+    User* user = findUserById(userId);
+    if (!user) return OpStatus::UserNotFound;
+
+    if (user->isActive) activeUsersCount--;
+    userCount--;
+    totalTasksCount -= static_cast<int>(user->tasks.size());
+    completedTasksCount -= user->completedCount;
+    for (const DueEntry& entry : user->dueIndex)
+    {
+        shard.dueIndex.erase(entry);
+        taskOwners.remove(entry.taskId, userId);
+        if (reminders) reminders->cancel(entry.taskId);
+    }
+
+    identities.remove(userId, user->username, user->email);
+    searchIndex.remove(userId, searchText(*user));
+    shard.users.erase(userId);
+    freeUserIds.push_back(userId);
+    shard.dirtyUsers.push_back(userId);
+    if (journal) journal->logDeleteUser(userId);
+    return OpStatus::Ok;
+}
+
+// O(1) task creation with title and date validation
+OpStatus UserManager::createTask(int userId, const string& title, const string& dueDate, int* newTaskId)
+{
+    OP_TIMER(Op::CreateTask);
+    UserShard& shard = shardFor(userId);
+    lock_guard<mutex> guard(shard.lock);
+    User* user = findUserById(userId);
+    if (!user) return OpStatus::UserNotFound;
+    if (title.empty() || title.length() > 100) return OpStatus::InvalidTitle;
+    uint32_t due = parseDueDate(dueDate);
+    if (due == 0) return OpStatus::InvalidDate;
+
+    int taskId = getNextTaskId();
+    // Built in place, so the title goes straight into the shard's pool
+    Task& task = user->tasks.try_emplace(taskId, taskId, title, due, "Ongoing").first->second;
+    trackTask(user, task, 1);
+    taskOwners.add(taskId, userId);
+    remindTask(userId, task);
+    if (journal) journal->logAddTask(userId, taskId, title, dueDate);
+
+    if (newTaskId)
+    {
+        *newTaskId = taskId;
+    }
+    return OpStatus::Ok;
+}
+
+// O(1) task title update
+OpStatus UserManager::setTaskTitle(int userId, int taskId, const string& title)
+{
+    OP_TIMER(Op::SetTaskTitle);
+    UserShard& shard = shardFor(userId);
+    lock_guard<mutex> guard(shard.lock);
+    User* user = findUserById(userId);
+    if (!user) return OpStatus::UserNotFound;
+    Task* task = findTaskById(user, taskId);
+    if (!task) return OpStatus::TaskNotFound;
+    if (title.empty() || title.length() > 100) return OpStatus::InvalidTitle;
+
+    task->title = title;
+    if (journal) journal->logEditTaskTitle(userId, taskId, title);
+    return OpStatus::Ok;
+}
+
+// O(1) task due date update
+OpStatus UserManager::setTaskDueDate(int userId, int taskId, const string& dueDate)
+{
+    OP_TIMER(Op::SetTaskDueDate);
+    UserShard& shard = shardFor(userId);
+    lock_guard<mutex> guard(shard.lock);
+    User* user = findUserById(userId);
+    if (!user) return OpStatus::UserNotFound;
+    Task* task = findTaskById(user, taskId);
+    if (!task) return OpStatus::TaskNotFound;
+    uint32_t due = parseDueDate(dueDate);
+    if (due == 0) return OpStatus::InvalidDate;
+
+    trackTask(user, *task, -1);
+    task->dueDate = due;
+    trackTask(user, *task, 1);
+    remindTask(userId, *task);
+    if (journal) journal->logEditTaskDueDate(userId, taskId, dueDate);
+    return OpStatus::Ok;
+}
+
+// O(1) task status update - accepts "Ongoing" or "Completed"
+OpStatus UserManager::setTaskStatus(int userId, int taskId, const string& status)
+{
+    OP_TIMER(Op::SetTaskStatus);
+    UserShard& shard = shardFor(userId);
+    lock_guard<mutex> guard(shard.lock);
+    User* user = findUserById(userId);
+    if (!user) return OpStatus::UserNotFound;
+    Task* task = findTaskById(user, taskId);
+    if (!task) return OpStatus::TaskNotFound;
+    if (status != "Ongoing" && status != "Completed") return OpStatus::InvalidStatus;
+
+    trackTask(user, *task, -1);
+    task->status = status;
+    trackTask(user, *task, 1);
+    remindTask(userId, *task);
+    if (journal) journal->logSetTaskStatus(userId, taskId, status);
+    return OpStatus::Ok;
+}
+
+// O(1) task completion
+OpStatus UserManager::completeTask(int userId, int taskId)
+{
+    OP_TIMER(Op::CompleteTask);
+    UserShard& shard = shardFor(userId);
+    lock_guard<mutex> guard(shard.lock);
+    User* user = findUserById(userId);
+    if (!user) return OpStatus::UserNotFound;
+    Task* task = findTaskById(user, taskId);
+    if (!task) return OpStatus::TaskNotFound;
+    if (task->status == "Completed") return OpStatus::AlreadyCompleted;
+
+    trackTask(user, *task, -1);
+    task->status = "Completed";
+    trackTask(user, *task, 1);
+    if (reminders) reminders->cancel(taskId);
+    if (journal) journal->logCompleteTask(userId, taskId);
+    return OpStatus::Ok;
+}
+
+// O(1) task deletion
+OpStatus UserManager::removeTask(int userId, int taskId)
+{
+    OP_TIMER(Op::RemoveTask);
+    UserShard& shard = shardFor(userId);
+    lock_guard<mutex> guard(shard.lock);
+    User* user = findUserById(userId);
+    if (!user) return OpStatus::UserNotFound;
+    Task* task = findTaskById(user, taskId);
+    if (!task) return OpStatus::TaskNotFound;
+
+    trackTask(user, *task, -1);
+    user->tasks.erase(taskId);
+    taskOwners.remove(taskId, userId);
+    if (reminders) reminders->cancel(taskId);
+    if (journal) journal->logDeleteTask(userId, taskId);
+    return OpStatus::Ok;
+}
+
+// Any user's task by its ID: the owner from the task index, then the task under
+// the owner's shard lock - O(1)
+OpStatus UserManager::findTask(int taskId, int* ownerId, Task* task) const
+{
+    OP_TIMER(Op::FindTask);
+    int userId = taskOwners.owner(taskId);
+    if (userId == 0 && !taskOwners.covers(taskId))
+    {
+        // Not indexed (an ID the counter never hands out) - look through every user
+        for (const auto& shard : shards)
+        {
+            lock_guard<mutex> guard(shard->lock);
+            shard->users.forEach([&](const User& user)
+            {
+                if (user.tasks.count(taskId)) userId = user.id;
+            });
+            if (userId != 0) break;
+        }
+    }
+    if (userId == 0) return OpStatus::TaskNotFound;
+
+    const UserShard& shard = shardFor(userId);
+    lock_guard<mutex> guard(shard.lock);
+    const User* user = shard.users.find(userId);
+    if (!user) return OpStatus::TaskNotFound;        // Removed since the index was read
+    auto it = user->tasks.find(taskId);
+    if (it == user->tasks.end()) return OpStatus::TaskNotFound;
+
+    if (ownerId) *ownerId = userId;
+    if (task) *task = it->second;
+    return OpStatus::Ok;
+}
+
+// Collect up to limit entries of one status block of an index between two dates
+static void collectDue(const DueIndex& index, bool completed, uint32_t from, uint32_t to,
+                       size_t limit, vector<DueEntry>& out)
+{
+    auto it = index.lower_bound({ completed, from, INT_MIN, 0 });
+    auto end = index.upper_bound({ completed, to, INT_MAX, 0 });
+    for (size_t taken = 0; it != end && taken < limit; ++it, ++taken)
+    {
+        out.push_back(*it);
+    }
+}
+
+// Tasks due in [from, to] in date order, from every shard's index or one user's index
+vector<DueEntry> UserManager::findTasksDue(uint32_t from, uint32_t to, bool ongoingOnly, int userId, size_t limit) const
+{
+    OP_TIMER(Op::FindTasksDue);
+    vector<DueEntry> result;
+    if (from > to) return result;
+
+    auto collect = [&](const DueIndex& index)
+    {
+        collectDue(index, false, from, to, limit, result);
+        if (!ongoingOnly) collectDue(index, true, from, to, limit, result);
+    };
+
+    if (userId != 0)
+    {
+        const UserShard& shard = shardFor(userId);
+        lock_guard<mutex> guard(shard.lock);
+        const User* user = shard.users.find(userId);
+        if (!user) return result;
+        collect(user->dueIndex);
+    }
+    else
+    {
+        for (const auto& shard : shards)
+        {
+            lock_guard<mutex> guard(shard->lock);
+            collect(shard->dueIndex);
+        }
+    }
+
+    // Each collected run is sorted by date - order the runs into one list
+    auto byDate = [](const DueEntry& a, const DueEntry& b)
+    {
+        return tie(a.dueDate, a.taskId) < tie(b.dueDate, b.taskId);
+    };
+    size_t kept = min(limit, result.size());
+    partial_sort(result.begin(), result.begin() + kept, result.end(), byDate);
+    result.resize(kept);
+    return result;
+}
+
+// Ongoing tasks with a due date before today
+vector<DueEntry> UserManager::findOverdueTasks(uint32_t today, int userId, size_t limit) const
+{
+    return findTasksDue(1, today - 1, true, userId, limit);
+}
+
+// ID, username and email joined by a separator that never appears in a keyword
+string UserManager::searchText(const User& user)
+{
+    return to_string(user.id) + '\n' + user.username + '\n' + user.email;
+}
+
+// Ranked substring search - candidates from the trigram index, verified against the real fields
+vector<int> UserManager::findUsersMatching(const string& keyword, size_t limit, size_t* totalMatches) const
+{
+    OP_TIMER(Op::FindUsersMatching);
+    // Lower rank is a better match
+    auto rankOf = [&](const User& user) -> int
+    {
+        if (user.username.compare(0, keyword.size(), keyword) == 0) return 0;
+        if (user.email.compare(0, keyword.size(), keyword) == 0) return 1;
+        if (user.username.find(keyword) != string::npos) return 2;
+        if (user.email.find(keyword) != string::npos) return 3;
+        if (to_string(user.id).find(keyword) != string::npos) return 4;
+        return -1;
+    };
+
+    struct Match
+    {
+        int rank;
+        size_t length;
+        int id;
+    };
+    vector<Match> matches;
+    auto consider = [&](const User& user)
+    {
+        int rank = rankOf(user);
+        if (rank >= 0)
+        {
+            matches.push_back({ rank, user.username.size(), user.id });
+        }
+    };
+
+    // identityLock covers the search index, the user slots and every
+    // username/email, and no user can be added or removed while it is held
+    lock_guard<mutex> guard(identityLock);
+    if (keyword.empty())
+    {
+        // Nothing to match
+    }
+    else if (keyword.size() >= TrigramIndex::MIN_QUERY_LENGTH)
+    {
+        for (int id : searchIndex.candidates(keyword))
+        {
+            if (const User* user = shardFor(id).users.find(id)) consider(*user);
+        }
+    }
+    else
+    {
+        // Too short for trigrams - O(n) scan
+        forEachUserById(consider);
+    }
+
+    if (totalMatches) *totalMatches = matches.size();
+
+    size_t shown = min(limit, matches.size());
+    partial_sort(matches.begin(), matches.begin() + shown, matches.end(), [](const Match& a, const Match& b)
+    {
+        return tie(a.rank, a.length, a.id) < tie(b.rank, b.length, b.id);
     });
 
-    for (const auto& user : sortedUsers)
+    vector<int> result;
+    result.reserve(shown);
+    for (size_t i = 0; i < shown; i++)
+    {
+        result.push_back(matches[i].id);
+    }
+    return result;
+}
+
+// Rows per screen page of the paged listings
+static const size_t USER_PAGE_ROWS = 50;
+static const size_t TASK_PAGE_ROWS = 20;
+
+// Pager prompt after a full page - false when the user stops (or input ends)
+static bool askNextPage()
+{
+    cout << "-- Enter for the next page, q to stop: ";
+    string answer;
+    if (!getline(cin, answer)) return false;
+    return answer.empty() || (answer[0] != 'q' && answer[0] != 'Q');
+}
+
+// Column layout of the admin user listings: ID, Username, Email, Status
+static vector<TableRenderer::Column> userColumns()
+{
+    using Align = TableRenderer::Align;
+    return {
+        { "ID", 5, Align::Right, false },
+        { "Username", 15, Align::Right, false },
+        { "Email", 25, Align::Right, false },
+        { "Status", 10, Align::Right, false }
+    };
+}
+
+// Display all users using hash table iteration
+void UserManager::viewAllUsers()
+{
+    cout << "\n--- All Users List ---\n";
+
+    // Pages in ID order from the admin view - no lock is held while printing
+    UserCursor cursor;
+    do
     {
-        string status = user.isActive ? "Active" : "Inactive";
-        cout << setw(5) << user.id
-             << setw(15) << user.username
-             << setw(25) << user.email
-             << setw(10) << status << endl;
+        writeUserPage(cout, cursor, USER_PAGE_ROWS);
     }
+    while (!cursor.done && askNextPage());
+}
+
+// One page of the user listing as a table - the body of viewAllUsers
+size_t UserManager::writeUserPage(ostream& out, UserCursor& cursor, size_t limit) const
+{
+    TableRenderer table(out, userColumns());
+    table.header();
+    return streamUsers(cursor, limit, [&](const UserSummary& user)
+    {
+        table.cell(user.id).cell(user.username).cell(user.email).cell(user.isActive ? "Active" : "Inactive");
+        table.endRow();
+    });
 }
 
 // Optimized search with hash table lookups
@@ -393,10 +1190,10 @@ void UserManager::searchUsers(const string& keyword)
     }
 
     // 3. Try as email (O(1))
-    auto emailIt = usersByEmail.find(keyword);
-    if (emailIt != usersByEmail.end())
+    int emailUserId = identities.findEmail(keyword);
+    if (emailUserId)
     {
-        User* userByEmailPtr = findUserById(emailIt->second);
+        User* userByEmailPtr = findUserById(emailUserId);
         if (userByEmailPtr)
         {
             cout << "Found by Email: " << userByEmailPtr->id << " " << userByEmailPtr->username
@@ -405,25 +1202,22 @@ void UserManager::searchUsers(const string& keyword)
         }
     }
 
-    // 4. Partial matching (still O(n) but faster iteration)
+    // 4. Partial matching through the trigram index, ranked and limited
     if (!found)
     {
-        for (const auto& pair : usersById)
+        const size_t shownLimit = 20;
+        size_t totalMatches = 0;
+        for (int id : findUsersMatching(keyword, shownLimit, &totalMatches))
         {
-            const User& user = pair.second;
-
-            // Convert ID to string for partial matching
-            string idStr = to_string(user.id);
-
-            if (idStr.find(keyword) != string::npos ||
-                    user.username.find(keyword) != string::npos ||
-                    user.email.find(keyword) != string::npos)
-            {
-
-                cout << "Found: " << user.id << " " << user.username
-                     << " " << user.email << " [" << (user.isActive ? "Active" : "Deactivated") << "]\n";
-                found = true;
-            }
+            const User* user = getUser(id);
+            cout << "Found: " << user->id << " " << user->username
+                 << " " << user->email << " [" << (user->isActive ? "Active" : "Deactivated") << "]\n";
+            found = true;
+        }
+        if (totalMatches > shownLimit)
+        {
+            cout << "... showing the best " << shownLimit << " of " << totalMatches
+                 << " matches, refine the search to narrow it down.\n";
         }
     }
 
@@ -456,77 +1250,48 @@ void UserManager::filterUsers()
         }
         cin.ignore(numeric_limits<streamsize>::max(), '\n');
 
-        bool found = false;
+        shared_ptr<const AdminView> view = adminView();
 
-        switch (choice)
+        // One table for the four filters: the rows whose summary passes keep
+        auto printFiltered = [&](const char* title, const char* emptyNote, bool (*keep)(const UserSummary&))
         {
-        case 1:
-        {
-            cout << "\n--- Active Users ---\n";
-            for (const auto& pair : usersById)
+            cout << title;
+            vector<TableRenderer::Column> columns = userColumns();
+            columns.push_back({ "Tasks", 7, TableRenderer::Align::Right, false });
+            TableRenderer table(cout, move(columns));
+            table.header();
+            for (const auto& summary : view->users)
             {
-                const User& user = pair.second;
-                if (user.isActive)
-                {
-                    cout << "ID: " << user.id << ", Username: " << user.username
-                         << ", Email: " << user.email << "\n";
-                    found = true;
-                }
+                const UserSummary& user = *summary;
+                if (!keep(user)) continue;
+                table.cell(user.id).cell(user.username).cell(user.email)
+                     .cell(user.isActive ? "Active" : "Inactive").cell(user.taskCount);
+                table.endRow();
             }
-            if (!found) cout << "No active users found.\n";
+            if (table.rowCount() == 0) table.line(emptyNote);
+        };
+
+        switch (choice)
+        {
+        case 1:
+            printFiltered("\n--- Active Users ---\n", "No active users found.",
+                          [](const UserSummary& user) { return user.isActive; });
             break;
-        }
 
         case 2:
-        {
-            cout << "\n--- Inactive Users ---\n";
-            for (const auto& pair : usersById)
-            {
-                const User& user = pair.second;
-                if (!user.isActive)
-                {
-                    cout << "ID: " << user.id << ", Username: " << user.username
-                         << ", Email: " << user.email << "\n";
-                    found = true;
-                }
-            }
-            if (!found) cout << "No inactive users found.\n";
+            printFiltered("\n--- Inactive Users ---\n", "No inactive users found.",
+                          [](const UserSummary& user) { return !user.isActive; });
             break;
-        }
 
         case 3:
-        {
-            cout << "\n--- Users with Tasks ---\n";
-            for (const auto& pair : usersById)
-            {
-                const User& user = pair.second;
-                if (!user.tasks.empty())
-                {
-                    cout << "ID: " << user.id << ", Username: " << user.username
-                         << ", Email: " << user.email << " (Tasks: " << user.tasks.size() << ")\n";
-                    found = true;
-                }
-            }
-            if (!found) cout << "No users with tasks found.\n";
+            printFiltered("\n--- Users with Tasks ---\n", "No users with tasks found.",
+                          [](const UserSummary& user) { return user.taskCount != 0; });
             break;
-        }
 
         case 4:
-        {
-            cout << "\n--- Users without Tasks ---\n";
-            for (const auto& pair : usersById)
-            {
-                const User& user = pair.second;
-                if (user.tasks.empty())
-                {
-                    cout << "ID: " << user.id << ", Username: " << user.username
-                         << ", Email: " << user.email << "\n";
-                    found = true;
-                }
-            }
-            if (!found) cout << "No users without tasks found.\n";
+            printFiltered("\n--- Users without Tasks ---\n", "No users without tasks found.",
+                          [](const UserSummary& user) { return user.taskCount == 0; });
             break;
-        }
 
         case 5:
         {
@@ -551,43 +1316,95 @@ void UserManager::filterUsers()
 // Display all user tasks using hash table iteration
 void UserManager::viewAllUserTasks()
 {
-    if (usersById.empty())
+    shared_ptr<const AdminView> view = adminView();
+    if (view->users.empty())
     {
         cout << "No users found in the system.\n";
         return;
     }
 
-    for (const auto& pair : usersById)
-    {
-        const User& user = pair.second;
-
-        int taskCount = user.tasks.size();
-        int completed = 0, ongoing = 0;
-
-        // Count completed and ongoing tasks
-        for (const auto& taskPair : user.tasks)
-        {
-            if (taskPair.second.status == "Completed")
-            {
-                completed++;
-            }
-            else
-            {
-                ongoing++;
-            }
-        }
+    cout << "\n--- Tasks per User ---\n";
+    UserCursor cursor;
+    do
+    {
+        writeTaskCountPage(cout, cursor, USER_PAGE_ROWS);
+    }
+    while (!cursor.done && askNextPage());
+}
 
-        cout << "\nUser ID: " << user.id << ", Name: " << user.username;
+// One page of per-user task counts as a table - the body of viewAllUserTasks
+size_t UserManager::writeTaskCountPage(ostream& out, UserCursor& cursor, size_t limit) const
+{
+    vector<TableRenderer::Column> columns = userColumns();
+    columns.push_back({ "Tasks", 7, TableRenderer::Align::Right, false });
+    columns.push_back({ "Completed", 11, TableRenderer::Align::Right, false });
+    columns.push_back({ "Ongoing", 9, TableRenderer::Align::Right, false });
+    TableRenderer table(out, move(columns));
+    table.header();
+
+    // O(1) per user - counts copied from the counters kept by every task mutation
+    return streamUsers(cursor, limit, [&](const UserSummary& user)
+    {
+        table.cell(user.id).cell(user.username).cell(user.email)
+             .cell(user.isActive ? "Active" : "DEACTIVATED")
+             .cell(user.taskCount).cell(user.completedCount).cell(user.taskCount - user.completedCount);
+        table.endRow();
+    });
+}
 
-        if (!user.isActive)
-        {
-            cout << " (DEACTIVATED)";
-        }
+// Admin screen: add every user of a CSV file as one batch, then list the rejected rows
+void UserManager::importUsersMenu()
+{
+    cout << "\n--- Import Users (CSV) ---\n";
+    cout << "Columns: username,email,password[,Active|Inactive]\n";
+    string filename;
+    cout << "CSV file: ";
+    getline(cin, filename);
+    if (filename.empty())
+    {
+        cout << "File name cannot be empty!\n";
+        return;
+    }
 
-        cout << ", Email: " << user.email << "\n";
-        cout << "Total Tasks: " << taskCount << ", Completed: " << completed
-             << ", Ongoing: " << ongoing << "\n";
+    string answer;
+    cout << "Import only if every row is valid? (y/n): ";
+    getline(cin, answer);
+    bool allOrNothing = !answer.empty() && (answer[0] == 'y' || answer[0] == 'Y');
+
+    ImportReport report = importUsersCsv(filename, allOrNothing);
+    if (report.status != OpStatus::Ok)
+    {
+        cout << opStatusMessage(report.status) << endl;
+        return;
     }
+    cout << "\nRows: " << report.rows << ", imported: " << report.userIds.size()
+         << ", rejected: " << report.rejected.size() << "\n";
+    if (!report.committed && report.rows > 0) cout << "No user was imported.\n";
+    if (report.rejected.empty()) return;
+
+    using Align = TableRenderer::Align;
+    size_t next = 0;
+    do
+    {
+        TableRenderer table(cout, {
+            { "Line", 8, Align::Left, false },
+            { "Reason", 36, Align::Left, true },
+            { "Value", 40, Align::Left, true }
+        });
+        table.header();
+        for (size_t end = min(report.rejected.size(), next + USER_PAGE_ROWS); next < end; next++)
+        {
+            const ImportRejection& rejection = report.rejected[next];
+            string value = rejection.value;
+            if (rejection.existingUserId) value += " (user " + to_string(rejection.existingUserId) + ")";
+            else if (rejection.earlierRow != SIZE_MAX) value += " (line " + to_string(rejection.earlierRow) + ")";
+            table.cell(static_cast<long long>(rejection.row))
+                 .cell(opStatusMessage(rejection.reason))
+                 .cell(value);
+            table.endRow();
+        }
+    }
+    while (next < report.rejected.size() && askNextPage());
 }
 
 // O(1) user activation toggle
@@ -600,7 +1417,7 @@ bool UserManager::toggleUserActivation(int id)
         return false;
     }
 
-    user->isActive = !user->isActive;
+    setUserActive(id, !user->isActive);
     if (user->isActive)
     {
         cout << "User " << user->username << " re-activated.\n";
@@ -613,10 +1430,12 @@ bool UserManager::toggleUserActivation(int id)
 }
 
 // O(1) user activity check
-bool UserManager::isUserActiveById(int id)
+bool UserManager::isUserActiveById(int id) const
 {
-    User* user = findUserById(id);
-    return (user && user->isActive);
+    const UserShard& shard = shardFor(id);
+    lock_guard<mutex> guard(shard.lock);
+    const User* user = shard.users.find(id);
+    return user && user->isActive;
 }
 
 // User Portal Menu
@@ -626,11 +1445,11 @@ void UserManager::userPortalMenu()
 
     do
     {
-        cout << "\n--------- USER PORTAL ---------" << endl;
-        cout << "1. Registration" << endl;
-        cout << "2. Log In" << endl;
-        cout << "3. Exit" << endl;
-        cout << "Enter your choice: ";
+        showMenu("\n--------- USER PORTAL ---------\n"
+                 "1. Registration\n"
+                 "2. Log In\n"
+                 "3. Exit\n"
+                 "Enter your choice: ");
 
         if (!(cin >> choice))
         {
@@ -645,7 +1464,7 @@ void UserManager::userPortalMenu()
         {
         case 1:
         {
-            system("cls");
+            clearScreen();
             cout << "\n--------- USER REGISTRATION ---------\n";
             if (userRegistration())
             {
@@ -656,7 +1475,7 @@ void UserManager::userPortalMenu()
 
         case 2:
         {
-            system("cls");
+            clearScreen();
             cout << "\n--------- USER LOGIN ---------" << endl;
             User* loggedInUser = userLogin();
             if (loggedInUser)
@@ -767,14 +1586,16 @@ bool UserManager::userRegistration()
     while (true);
 
     // Create new user account using O(1) hash table insertion
-    if (addUser(username, email, password))
+    int newUserId = 0;
+    OpStatus result = registerUser(username, email, password, &newUserId);
+    if (result == OpStatus::Ok)
     {
         cout << "\nAccount created successfully!" << endl;
         cout << "Username: " << username << endl;
         cout << "Email: " << email << endl;
 
         // Auto-login after registration
-        User* newUser = findUserByUsername(username);
+        User* newUser = findUserById(newUserId);
         if (newUser)
         {
             userDashboard(newUser);
@@ -783,6 +1604,7 @@ bool UserManager::userRegistration()
     }
     else
     {
+        cout << opStatusMessage(result) << endl;
         cout << "Failed to create account. Please try again." << endl;
     }
 
@@ -826,7 +1648,7 @@ User* UserManager::userLogin()
         cout << "Enter password: ";
         getline(cin, password);
 
-        if (user->password == password)
+        if (loginUser(username, password) == OpStatus::Ok)
         {
             return user; // Successful login
         }
@@ -843,7 +1665,7 @@ User* UserManager::userLogin()
     // Deactivate user after 3 failed attempts
     cout << "\nToo many failed login attempts. Your account has been deactivated for security." << endl;
     cout << "Please contact administrator to reactivate your account." << endl;
-    user->isActive = false;
+    setUserActive(user->id, false);
 
     return nullptr;
 }
@@ -852,18 +1674,21 @@ User* UserManager::userLogin()
 void UserManager::userDashboard(User* currentUser)
 {
     int choice;
+    UserHandle session = handleOf(currentUser->id);
 
     do
     {
-        cout << "\n--------- USER DASHBOARD ---------" << endl;
-        cout << "Welcome, " << currentUser->username << "!\n";
-        cout << "Account Status: " << (currentUser->isActive ? "Active" : "Deactivated") << endl;
-        cout << "Email: " << currentUser->email << endl;
-        cout << "User ID: " << currentUser->id << endl;
-        cout << "\n1. Edit Profile" << endl;
-        cout << "2. Task Management" << endl;
-        cout << "3. Logout" << endl;
-        cout << "Enter your choice: ";
+        ostringstream frame;
+        frame << "\n--------- USER DASHBOARD ---------\n";
+        frame << "Welcome, " << currentUser->username << "!\n";
+        frame << "Account Status: " << (currentUser->isActive ? "Active" : "Deactivated") << "\n";
+        frame << "Email: " << currentUser->email << "\n";
+        frame << "User ID: " << currentUser->id << "\n";
+        frame << "\n1. Edit Profile\n";
+        frame << "2. Task Management\n";
+        frame << "3. Logout\n";
+        frame << "Enter your choice: ";
+        showMenu(frame.str());
 
         if (!(cin >> choice))
         {
@@ -878,14 +1703,14 @@ void UserManager::userDashboard(User* currentUser)
         {
         case 1:
         {
-            system("cls");
+            clearScreen();
             editProfile(currentUser);
             break;
         }
 
         case 2:
         {
-            system("cls");
+            clearScreen();
             taskManagement(currentUser);
             break;
         }
@@ -903,6 +1728,9 @@ void UserManager::userDashboard(User* currentUser)
         }
         }
 
+        // The account was deleted from the profile menu - the session is over
+        if (!isCurrent(session)) return;
+
         if (choice != 3)
         {
             cout << "\nPress Enter to continue...";
@@ -955,36 +1783,25 @@ void UserManager::editProfile(User* currentUser)
                 cout << "Enter new username: ";
                 getline(cin, newUsername);
 
-                if (newUsername.empty())
+                OpStatus result = changeUsername(currentUser->id, newUsername);
+                if (result == OpStatus::InvalidUsername)
                 {
                     cout << "Username cannot be empty!\n";
                     continue;
                 }
 
-                if (newUsername == currentUser->username)
+                if (result == OpStatus::NoChange)
                 {
                     cout << "New username is same as current username!" << endl;
                     break;
                 }
 
-                if (!isUsernameUnique(newUsername))
+                if (result == OpStatus::UsernameTaken)
                 {
                     cout << "Username '" << newUsername << "' is already taken!" << endl;
                     continue;
                 }
 
-                // Update hash tables
-                string oldUsername = currentUser->username;
-
-                // Remove old username from hash tables
-                usersByUsername.erase(oldUsername);
-                usedUsernames.erase(oldUsername);
-
-                // Update user and add new username to hash tables
-                currentUser->username = newUsername;
-                usersByUsername[newUsername] = currentUser->id;
-                usedUsernames.insert(newUsername);
-
                 cout << "Username updated successfully to: " << newUsername << endl;
                 break;
 
@@ -1029,7 +1846,7 @@ void UserManager::editProfile(User* currentUser)
                 }
 
                 // Update password
-                currentUser->password = newPass;
+                changePassword(currentUser->id, currentPass, newPass);
                 cout << "Password changed successfully!" << endl;
                 break;
 
@@ -1056,36 +1873,25 @@ void UserManager::editProfile(User* currentUser)
                     continue;
                 }
 
-                if (newEmail == currentUser->email)
+                OpStatus result = changeEmail(currentUser->id, newEmail);
+                if (result == OpStatus::NoChange)
                 {
                     cout << "New email is same as current email!" << endl;
                     break;
                 }
 
-                if (!isValidEmail(newEmail))
+                if (result == OpStatus::InvalidEmail)
                 {
                     cout << "Invalid email format!" << endl;
                     continue;
                 }
 
-                if (!isEmailUnique(newEmail))
+                if (result == OpStatus::EmailTaken)
                 {
                     cout << "Email '" << newEmail << "' is already registered!" << endl;
                     continue;
                 }
 
-                // Update hash tables
-                string oldEmail = currentUser->email;
-
-                // Remove old email from hash tables
-                usersByEmail.erase(oldEmail);
-                usedEmails.erase(oldEmail);
-
-                // Update user and add new email to hash tables
-                currentUser->email = newEmail;
-                usersByEmail[newEmail] = currentUser->id;
-                usedEmails.insert(newEmail);
-
                 cout << "Email updated successfully to: " << newEmail << endl;
                 break;
 
@@ -1131,37 +1937,30 @@ void UserManager::taskManagement(User* currentUser)
 
     do
     {
-        cout << "\n--------- TASK MANAGEMENT ---------\n";
-        cout << "User: " << currentUser->username << "\n";
+        ostringstream frame;
+        frame << "\n--------- TASK MANAGEMENT ---------\n";
+        frame << "User: " << currentUser->username << "\n";
 
-        // O(1) task counting using hash table size
+        // O(1) task counting using hash table size and the per-user counter
         int totalTasks = currentUser->tasks.size();
-        int completedTasks = 0, ongoingTasks = 0;
-
-        for (const auto& pair : currentUser->tasks)
-        {
-            if (pair.second.status == "Completed")
-            {
-                completedTasks++;
-            }
-            else
-            {
-                ongoingTasks++;
-            }
-        }
-
-        cout << "Total Tasks: " << totalTasks;
-        cout << " | Completed: " << completedTasks;
-        cout << " | Ongoing: " << ongoingTasks << "\n";
-
-        cout << "\n1. Add New Task\n";
-        cout << "2. View All Tasks\n";
-        cout << "3. Edit Task\n";
-        cout << "4. Mark Task as Completed\n";
-        cout << "5. Delete Task\n";
-        cout << "6. View Task Details\n";
-        cout << "7. Back to Dashboard\n";
-        cout << "Enter your choice: ";
+        int completedTasks = currentUser->completedCount;
+        int ongoingTasks = currentUser->ongoingCount();
+
+        frame << "Total Tasks: " << totalTasks;
+        frame << " | Completed: " << completedTasks;
+        frame << " | Ongoing: " << ongoingTasks << "\n";
+
+        frame << "\n1. Add New Task\n";
+        frame << "2. View All Tasks\n";
+        frame << "3. Edit Task\n";
+        frame << "4. Mark Task as Completed\n";
+        frame << "5. Delete Task\n";
+        frame << "6. View Task Details\n";
+        frame << "7. Upcoming & Overdue Tasks\n";
+        frame << "8. Bulk Actions\n";
+        frame << "9. Back to Dashboard\n";
+        frame << "Enter your choice: ";
+        showMenu(frame.str());
 
         if (!(cin >> choice))
         {
@@ -1211,6 +2010,18 @@ void UserManager::taskManagement(User* currentUser)
         }
 
         case 7:
+        {
+            viewUpcomingTasks(currentUser);
+            break;
+        }
+
+        case 8:
+        {
+            bulkTaskMenu(currentUser->id);
+            break;
+        }
+
+        case 9:
         {
             cout << "\nReturning to dashboard...\n";
             break;
@@ -1223,14 +2034,14 @@ void UserManager::taskManagement(User* currentUser)
         }
         }
 
-        if (choice != 7)
+        if (choice != 9)
         {
             cout << "\nPress Enter to continue...";
             cin.get();
         }
 
     }
-    while (choice != 7);
+    while (choice != 9);
 }
 
 // O(1) task addition using hash table
@@ -1282,12 +2093,14 @@ void UserManager::addTask(User* currentUser)
     }
     while (true);
 
-    // Create new task with unique ID
-    int taskId = getNextTaskId();
-    Task newTask(taskId, title, dueDate, "Ongoing");
-
-    // O(1) insertion into hash table
-    currentUser->tasks[taskId] = newTask;
+    // Create new task with unique ID - O(1) insertion into hash table
+    int taskId = 0;
+    OpStatus result = createTask(currentUser->id, title, dueDate, &taskId);
+    if (result != OpStatus::Ok)
+    {
+        cout << opStatusMessage(result) << "\n";
+        return;
+    }
 
     cout << "\nTask added successfully!\n";
     cout << "Task ID: " << taskId << "\n";
@@ -1296,6 +2109,19 @@ void UserManager::addTask(User* currentUser)
     cout << "Status: Ongoing\n";
 }
 
+// Column layout of the task listings: ID, Title (truncated), Due Date and optionally Status
+static vector<TableRenderer::Column> taskColumns(bool withStatus)
+{
+    using Align = TableRenderer::Align;
+    vector<TableRenderer::Column> columns = {
+        { "ID", 8, Align::Left, false },
+        { "Title", 25, Align::Left, true },
+        { "Due Date", 12, Align::Left, false }
+    };
+    if (withStatus) columns.push_back({ "Status", 12, Align::Left, false });
+    return columns;
+}
+
 // View all tasks using hash table iteration
 void UserManager::viewUserTasks(User* currentUser)
 {
@@ -1307,29 +2133,61 @@ void UserManager::viewUserTasks(User* currentUser)
         return;
     }
 
-    cout << left << setw(8) << "ID";
-    cout << setw(25) << "Title";
-    cout << setw(12) << "Due Date";
-    cout << setw(12) << "Status" << "\n";
-    cout << string(57, '-') << "\n";
+    // Pages in due-index order: ongoing tasks by due date, then completed ones.
+    // Also the picker of edit, delete and details, so a long list stops early.
+    TaskCursor cursor;
+    do
+    {
+        writeTaskPage(cout, currentUser->id, cursor, TASK_PAGE_ROWS);
+    }
+    while (!cursor.done && askNextPage());
+}
 
-    // Iterate through hash table
-    for (const auto& pair : currentUser->tasks)
+// One page of a user's tasks as a table - the body of viewUserTasks
+size_t UserManager::writeTaskPage(ostream& out, int userId, TaskCursor& cursor, size_t limit) const
+{
+    TableRenderer table(out, taskColumns(true));
+    table.header();
+    return streamUserTasks(userId, cursor, limit, [&](const Task& task)
     {
-        const Task& task = pair.second;
+        table.cell(task.taskId).cell(task.title).cell(unpackDate(task.dueDate)).cell(task.status);
+        table.endRow();
+    });
+}
 
-        cout << left << setw(8) << task.taskId;
+// Overdue and next-7-days tasks straight from the user's due-date index
+void UserManager::viewUpcomingTasks(User* currentUser)
+{
+    uint32_t today = todayPacked();
+    vector<DueEntry> overdue = findOverdueTasks(today, currentUser->id);
+    vector<DueEntry> upcoming = findTasksDue(today, packedDateAfterDays(7), true, currentUser->id);
 
-        // Truncate long titles
-        string displayTitle = task.title;
-        if (displayTitle.length() > 24)
+    // Rows are read under the shard lock; tasks deleted since the queries are skipped
+    auto printEntries = [&](const vector<DueEntry>& entries, const char* emptyNote)
+    {
+        if (entries.empty())
         {
-            displayTitle = displayTitle.substr(0, 21) + "...";
+            cout << emptyNote;
+            return;
         }
-        cout << setw(25) << displayTitle;
-        cout << setw(12) << task.dueDate;
-        cout << setw(12) << task.status << "\n";
-    }
+        TableRenderer table(cout, taskColumns(false));
+        table.header();
+        lock_guard<mutex> guard(shardFor(currentUser->id).lock);
+        for (const DueEntry& entry : entries)
+        {
+            auto found = currentUser->tasks.find(entry.taskId);
+            if (found == currentUser->tasks.end()) continue;
+            const Task& task = found->second;
+            table.cell(task.taskId).cell(task.title).cell(unpackDate(task.dueDate));
+            table.endRow();
+        }
+    };
+
+    cout << "\n--- Overdue Tasks (" << overdue.size() << ") ---\n";
+    printEntries(overdue, "Nothing overdue.\n");
+
+    cout << "\n--- Due in the Next 7 Days (" << upcoming.size() << ") ---\n";
+    printEntries(upcoming, "Nothing due this week.\n");
 }
 
 // O(1) task lookup and editing
@@ -1368,7 +2226,7 @@ void UserManager::editTask(User* currentUser)
     cout << "\nCurrent Task Details:\n";
     cout << "ID: " << task->taskId << "\n";
     cout << "Title: " << task->title << "\n";
-    cout << "Due Date: " << task->dueDate << "\n";
+    cout << "Due Date: " << unpackDate(task->dueDate) << "\n";
     cout << "Status: " << task->status << "\n";
 
     int choice;
@@ -1396,9 +2254,8 @@ void UserManager::editTask(User* currentUser)
         cout << "Enter new title: ";
         getline(cin, newTitle);
 
-        if (!newTitle.empty() && newTitle.length() <= 100)
+        if (setTaskTitle(currentUser->id, taskId, newTitle) == OpStatus::Ok)
         {
-            task->title = newTitle;
             cout << "Title updated successfully!\n";
         }
         else
@@ -1414,9 +2271,8 @@ void UserManager::editTask(User* currentUser)
         cout << "Enter new due date (DD/MM/YYYY): ";
         getline(cin, newDueDate);
 
-        if (isValidDate(newDueDate))
+        if (setTaskDueDate(currentUser->id, taskId, newDueDate) == OpStatus::Ok)
         {
-            task->dueDate = newDueDate;
             cout << "Due date updated successfully!\n";
         }
         else
@@ -1438,12 +2294,12 @@ void UserManager::editTask(User* currentUser)
         {
             if (statusChoice == 1)
             {
-                task->status = "Ongoing";
+                setTaskStatus(currentUser->id, taskId, "Ongoing");
                 cout << "Status updated to Ongoing!\n";
             }
             else if (statusChoice == 2)
             {
-                task->status = "Completed";
+                setTaskStatus(currentUser->id, taskId, "Completed");
                 cout << "Status updated to Completed!\n";
             }
             else
@@ -1486,28 +2342,20 @@ void UserManager::markTaskCompleted(User* currentUser)
 
     // Show only ongoing tasks
     cout << "Ongoing Tasks:\n";
-    cout << left << setw(8) << "ID";
-    cout << setw(25) << "Title";
-    cout << setw(12) << "Due Date" << "\n";
-    cout << string(45, '-') << "\n";
-
     bool hasOngoingTasks = false;
-    for (const auto& pair : currentUser->tasks)
     {
-        const Task& task = pair.second;
-        if (task.status == "Ongoing")
+        TableRenderer table(cout, taskColumns(false));
+        table.header();
+        for (const auto& pair : currentUser->tasks)
         {
-            hasOngoingTasks = true;
-            cout << left << setw(8) << task.taskId;
-
-            string displayTitle = task.title;
-            if (displayTitle.length() > 24)
+            const Task& task = pair.second;
+            if (task.status == "Ongoing")
             {
-                displayTitle = displayTitle.substr(0, 21) + "...";
+                table.cell(task.taskId).cell(task.title).cell(unpackDate(task.dueDate));
+                table.endRow();
             }
-            cout << setw(25) << displayTitle;
-            cout << setw(12) << task.dueDate << "\n";
         }
+        hasOngoingTasks = table.rowCount() > 0;
     }
 
     if (!hasOngoingTasks)
@@ -1528,20 +2376,20 @@ void UserManager::markTaskCompleted(User* currentUser)
     cin.ignore();
 
     // O(1) task lookup and update
-    Task* task = findTaskById(currentUser, taskId);
-    if (task == nullptr)
+    OpStatus result = completeTask(currentUser->id, taskId);
+    if (result == OpStatus::TaskNotFound)
     {
         cout << "Task with ID " << taskId << " not found!\n";
         return;
     }
 
-    if (task->status == "Completed")
+    if (result == OpStatus::AlreadyCompleted)
     {
         cout << "Task is already completed!\n";
         return;
     }
 
-    task->status = "Completed";
+    Task* task = findTaskById(currentUser, taskId);
     cout << "\nTask marked as completed successfully!\n";
     cout << "Task: " << task->title << "\n";
     cout << "Congratulations on completing your task!\n";
@@ -1582,7 +2430,7 @@ void UserManager::deleteTask(User* currentUser)
     cout << "\nTask to delete:\n";
     cout << "ID: " << task->taskId << "\n";
     cout << "Title: " << task->title << "\n";
-    cout << "Due Date: " << task->dueDate << "\n";
+    cout << "Due Date: " << unpackDate(task->dueDate) << "\n";
     cout << "Status: " << task->status << "\n";
 
     string confirmation;
@@ -1596,10 +2444,98 @@ void UserManager::deleteTask(User* currentUser)
     }
 
     // O(1) deletion from hash table
-    currentUser->tasks.erase(taskId);
+    removeTask(currentUser->id, taskId);
     cout << "\nTask deleted successfully!\n";
 }
 
+// Bulk task actions for one user's tasks, or every user's when userId is 0 (admin)
+void UserManager::bulkTaskMenu(int userId)
+{
+    cout << "\n--- Bulk Task Actions (" << (userId ? "your tasks" : "all users") << ") ---\n";
+    cout << "1. Complete all tasks due before a date\n";
+    cout << "2. Complete tasks by ID\n";
+    cout << "3. Delete all completed tasks\n";
+    cout << "4. Cancel\n";
+    cout << "Enter your choice: ";
+
+    int choice;
+    if (!(cin >> choice))
+    {
+        cout << "Invalid input! Please enter a number.\n";
+        cin.clear();
+        cin.ignore(1000, '\n');
+        return;
+    }
+    cin.ignore(1000, '\n');
+
+    TaskFilter filter;
+    size_t count = 0;
+    switch (choice)
+    {
+    case 1:
+    {
+        string date;
+        cout << "Complete every ongoing task due before (DD/MM/YYYY): ";
+        getline(cin, date);
+        uint32_t before = parseDueDate(date);
+        if (before == 0)
+        {
+            cout << "Invalid date! Use DD/MM/YYYY.\n";
+            return;
+        }
+        filter.dueFrom = 1;                // Undated tasks are never due
+        filter.dueTo = before - 1;
+        completeTasks(userId, filter, &count);
+        cout << "\n" << count << " task(s) marked as completed.\n";
+        break;
+    }
+
+    case 2:
+    {
+        string line;
+        cout << "Task IDs to complete (separated by spaces or commas): ";
+        getline(cin, line);
+        replace(line.begin(), line.end(), ',', ' ');
+        istringstream ids(line);
+        for (int id; ids >> id; )
+        {
+            filter.taskIds.push_back(id);
+        }
+        if (filter.taskIds.empty())
+        {
+            cout << "No task IDs entered.\n";
+            return;
+        }
+        completeTasks(userId, filter, &count);
+        cout << "\n" << count << " of " << filter.taskIds.size() << " task(s) marked as completed.\n";
+        break;
+    }
+
+    case 3:
+    {
+        string confirmation;
+        cout << "Type 'DELETE' to delete every completed task: ";
+        getline(cin, confirmation);
+        if (confirmation != "DELETE")
+        {
+            cout << "Deletion cancelled.\n";
+            return;
+        }
+        filter.status = TaskFilter::Status::Completed;
+        removeTasks(userId, filter, &count);
+        cout << "\n" << count << " completed task(s) deleted.\n";
+        break;
+    }
+
+    case 4:
+        break;
+
+    default:
+        cout << "\nInvalid choice!\n";
+        break;
+    }
+}
+
 // O(1) task details viewing
 void UserManager::viewTaskDetails(User* currentUser)
 {
@@ -1635,7 +2571,7 @@ void UserManager::viewTaskDetails(User* currentUser)
     cout << "\n---------- TASK DETAILS ----------\n";
     cout << "Task ID: " << task->taskId << "\n";
     cout << "Title: " << task->title << "\n";
-    cout << "Due Date: " << task->dueDate << "\n";
+    cout << "Due Date: " << unpackDate(task->dueDate) << "\n";
     cout << "Status: " << task->status << "\n";
     cout << "--------------------------------\n";
 
@@ -1649,6 +2585,39 @@ void UserManager::viewTaskDetails(User* currentUser)
     }
 }
 
+// Admin screen: whose task is this - any task ID, no user needed
+void UserManager::findTaskMenu()
+{
+    cout << "\n--- Find Task by ID ---\n";
+    int taskId;
+    cout << "Enter Task ID: ";
+    if (!(cin >> taskId))
+    {
+        cout << "Invalid Task ID!\n";
+        cin.clear();
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        return;
+    }
+    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+
+    int ownerId = 0;
+    Task task;
+    if (findTask(taskId, &ownerId, &task) != OpStatus::Ok)
+    {
+        cout << "Task with ID " << taskId << " not found!\n";
+        return;
+    }
+
+    const User* owner = getUser(ownerId);
+    cout << "\n---------- TASK DETAILS ----------\n";
+    cout << "Task ID: " << task.taskId << "\n";
+    cout << "Owner: " << (owner ? owner->username : string("?")) << " (User ID " << ownerId << ")\n";
+    cout << "Title: " << task.title << "\n";
+    cout << "Due Date: " << unpackDate(task.dueDate) << "\n";
+    cout << "Status: " << task.status << "\n";
+    cout << "--------------------------------\n";
+}
+
 // O(1) task lookup by ID using hash table
 Task* UserManager::findTaskById(User* currentUser, int taskId)
 {
@@ -1693,11 +2662,7 @@ void UserManager::deleteUserAccount(User* currentUser)
     int userId = currentUser->id;
 
     // Remove from all hash tables - O(1) operations
-    usersById.erase(userId);
-    usersByUsername.erase(currentUser->username);
-    usersByEmail.erase(currentUser->email);
-    usedUsernames.erase(currentUser->username);
-    usedEmails.erase(currentUser->email);
+    removeUser(userId);
 
     cout << "\nAccount '" << username << "' has been permanently deleted.\n";
     cout << "Thank you for using our system. Goodbye!\n";
@@ -1706,14 +2671,229 @@ void UserManager::deleteUserAccount(User* currentUser)
     cin.get();
 }
 
-// Save all user data and tasks to a file
-void UserManager::saveToFile(const string& filename)
+// Insert a user read from a data file into all hash tables, replacing any user with the same ID
+User* UserManager::restoreUser(int id, const string& username, const string& email, const string& password, bool isActive)
+{
+    return restoreUser(User(id, username, email, password, isActive));
+}
+
+// Move a fully built user (tasks included) into all hash tables
+User* UserManager::restoreUser(User&& loaded)
+{
+    int id = loaded.id;
+    UserShard& shard = shardFor(id);
+    User* existing = findUserById(id);
+    if (!existing)
+    {
+        userCount++;
+        // A journal replay can bring back a deleted ID - it is no longer free
+        auto freed = find(freeUserIds.begin(), freeUserIds.end(), id);
+        if (freed != freeUserIds.end()) freeUserIds.erase(freed);
+    }
+    else
+    {
+        if (existing->isActive) activeUsersCount--;
+        totalTasksCount -= static_cast<int>(existing->tasks.size());
+        completedTasksCount -= existing->completedCount;
+        for (const DueEntry& entry : existing->dueIndex)
+        {
+            shard.dueIndex.erase(entry);
+            taskOwners.remove(entry.taskId, id);
+            if (reminders) reminders->cancel(entry.taskId);
+        }
+        identities.remove(id, existing->username, existing->email);
+        searchIndex.remove(id, searchText(*existing));
+    }
+
+    User& user = shard.users.insert(id);
+    user = move(loaded);
+    user.viewDirty = false;
+    markViewDirty(&user);
+    if (user.isActive) activeUsersCount++;
+    totalTasksCount += static_cast<int>(user.tasks.size());
+    completedTasksCount += user.completedCount;
+    identities.add(id, user.username, user.email);
+    searchIndex.add(id, searchText(user));
+
+    // Loaders hand over tasks without index entries
+    user.dueIndex.clear();
+    for (const auto& taskPair : user.tasks)
+    {
+        const Task& task = taskPair.second;
+        DueEntry entry = { task.status == "Completed", task.dueDate, task.taskId, id };
+        user.dueIndex.insert(user.dueIndex.end(), entry);
+        shard.dueIndex.insert(entry);
+        taskOwners.add(task.taskId, id);
+        remindTask(id, task);
+    }
+
+    // Update user counter to ensure they're correct
+    if (id >= userIdCounter)
+    {
+        userIdCounter = id + 1;
+    }
+    return &user;
+}
+
+// Insert a task read from a data file
+void UserManager::restoreTask(User* user, int taskId, const string& title, uint32_t dueDate, const string& status)
+{
+    Task* existing = findTaskById(user, taskId);
+    if (existing)
+    {
+        trackTask(user, *existing, -1);
+        existing->title = title;
+        existing->dueDate = dueDate;
+        existing->status = status;
+        trackTask(user, *existing, 1);
+        remindTask(user->id, *existing);
+        return;
+    }
+
+    Task& task = user->tasks.try_emplace(taskId, taskId, title, dueDate, status).first->second;
+    trackTask(user, task, 1);
+    taskOwners.add(taskId, user->id);
+    remindTask(user->id, task);
+}
+
+// Re-apply one journaled mutation. Records hold absolute values and explicit
+// IDs, so applying a record that is already in the snapshot changes nothing.
+void UserManager::applyJournalRecord(const JournalRecord& rec)
+{
+    User* user = findUserById(rec.userId);
+
+    switch (rec.op)
+    {
+    case JournalOp::AddUser:
+        if (!user && rec.userId > 0) // Already present when the snapshot is newer than the record
+        {
+            restoreUser(rec.userId, rec.text1, rec.text2, rec.text3, true);
+        }
+        break;
+
+    case JournalOp::AddTask:
+        if (user)
+        {
+            restoreTask(user, rec.taskId, rec.text1, packDate(rec.text2), "Ongoing");
+            if (rec.taskId >= taskIdCounter) taskIdCounter = rec.taskId + 1;
+        }
+        break;
+
+    case JournalOp::EditTaskTitle:
+        setTaskTitle(rec.userId, rec.taskId, rec.text1);
+        break;
+
+    case JournalOp::EditTaskDueDate:
+        setTaskDueDate(rec.userId, rec.taskId, rec.text1);
+        break;
+
+    case JournalOp::SetTaskStatus:
+        setTaskStatus(rec.userId, rec.taskId, rec.text1);
+        break;
+
+    case JournalOp::CompleteTask:
+        setTaskStatus(rec.userId, rec.taskId, "Completed");
+        break;
+
+    case JournalOp::DeleteTask:
+        removeTask(rec.userId, rec.taskId);
+        break;
+
+    case JournalOp::SetUserActive:
+        setUserActive(rec.userId, rec.flag != 0);
+        break;
+
+    case JournalOp::DeleteUser:
+        removeUser(rec.userId);
+        break;
+
+    case JournalOp::ChangeUsername:
+        changeUsername(rec.userId, rec.text1);
+        break;
+
+    case JournalOp::ChangeEmail:
+        changeEmail(rec.userId, rec.text1);
+        break;
+
+    case JournalOp::ChangePassword:
+        if (user) user->password = rec.text1;
+        break;
+    }
+}
+
+// Replay a journal on top of the loaded snapshot
+bool UserManager::replayJournal(const string& filename)
+{
+    OP_TIMER(Op::ReplayJournal);
+    // Replayed mutations must not be journaled again
+    Journal* active = journal;
+    journal = nullptr;
+
+    int records = 0;
+    bool ok = Journal::replay(filename, [&](const JournalRecord& rec)
+    {
+        applyJournalRecord(rec);
+        records++;
+    });
+
+    journal = active;
+    if (!ok)
+    {
+        cerr << "Error: " << filename << " is not a journal file" << endl;
+        return false;
+    }
+    if (records > 0)
+    {
+        cout << "Replayed " << records << " journal records." << endl;
+    }
+    return true;
+}
+
+// Write a fresh snapshot and drop the journal records it now contains - the
+// journal is only emptied once writeSnapshot has the new snapshot on disk
+bool UserManager::checkpoint(const string& snapshotFile)
+{
+    OP_TIMER(Op::Checkpoint);
+    // Writers stay blocked until the journal is emptied, so no record falls in between
+    auto locks = lockAll();
+    if (journal) journal->flush();
+    uint64_t bytes = 0;
+    bool saved = writeSnapshot(snapshotFile, &bytes);
+    OP_BYTES(bytes);
+    if (!saved) return false;
+    return journal ? journal->truncate() : true;
+}
+
+// Schedule every ongoing task with a date straight from the shards' due
+// indexes (the ongoing block, in date order), writers stopped meanwhile
+void UserManager::attachReminders(ReminderScheduler* scheduler)
+{
+    auto locks = lockAll();
+    reminders = scheduler;
+    if (!scheduler) return;
+
+    scheduler->clear();
+    scheduler->reserve(static_cast<size_t>(totalTasksCount - completedTasksCount));
+    for (const auto& shard : shards)
+    {
+        for (auto it = shard->dueIndex.lower_bound({ false, 1, INT_MIN, 0 });
+                it != shard->dueIndex.end() && !it->completed; ++it)
+        {
+            scheduler->schedule(it->userId, it->taskId, it->dueDate);
+        }
+    }
+}
+
+// Save all user data and tasks to a file - false when it could not be written
+bool UserManager::saveToFile(const string& filename)
 {
+    OP_TIMER(Op::SaveToFile);
+    auto locks = lockAll();
     ofstream file(filename);
     if (!file.is_open())
     {
         cerr << "Error: Could not save data to file " << filename << endl;
-        return;
+        return false;
     }
 
     // Header
@@ -1725,19 +2905,9 @@ void UserManager::saveToFile(const string& filename)
          << "Password" << "      "
          << "Status" << endl;
 
-    // To get users in ascending order, we must create a vector and sort it
-    vector<User> sortedUsers;
-    for (const auto& pair : usersById)
-    {
-        sortedUsers.push_back(pair.second);
-    }
-    sort(sortedUsers.begin(), sortedUsers.end(), [](const User& a, const User& b)
-    {
-        return a.id < b.id;
-    });
-
-    // Iterate through sorted users and their tasks
-    for (const auto& user : sortedUsers)
+    // Users in ascending order straight from the user slots
+    string title_with_underscores;
+    forEachUserById([&](const User& user)
     {
         // Only save valid users with proper data
         if (user.id > 0 && !user.username.empty() && !user.email.empty())
@@ -1751,34 +2921,47 @@ void UserManager::saveToFile(const string& filename)
             for (const auto& taskPair : user.tasks)
             {
                 const Task& task = taskPair.second;
-                string title_with_underscores = task.title;
+                title_with_underscores.assign(task.title); // Reuses the buffer's capacity
                 replace(title_with_underscores.begin(), title_with_underscores.end(), ' ', '_');
                 file << "TASK " << task.taskId << " "
                      << title_with_underscores << " "
-                     << task.dueDate << " "
+                     << unpackDate(task.dueDate) << " "
                      << task.status << "\n";
             }
         }
-    }
+    });
 
     // Footer
-    file << "\n=====>>> Total Users: " << usersById.size() << "!\n";
+    file << "\n=====>>> Total Users: " << userCount << "!\n";
 
+    OP_BYTES(static_cast<uint64_t>(file.tellp()));
     file.close();
+    if (!file)
+    {
+        cerr << "Error: Could not write data file " << filename << endl;
+        return false;
+    }
     cout << "Data saved successfully to " << filename << endl;
+    return true;
 }
 
 
-// Load data from file
-void UserManager::loadFromFile(const string& filename)
+// Load data from file - false when it could not be opened or read
+bool UserManager::loadFromFile(const string& filename)
 {
+    OP_TIMER(Op::LoadFromFile);
     ifstream file(filename);
 
     if (!file.is_open())
     {
         cerr << "Error: Could not open data file " << filename << endl;
-        return;
+        return false;
     }
+#ifndef TASK_PLANNER_NO_METRICS
+    file.seekg(0, ios::end);
+    OP_BYTES(static_cast<uint64_t>(file.tellg()));
+    file.seekg(0);
+#endif
 
     // Skip the decorated header lines
     string line;
@@ -1793,6 +2976,10 @@ void UserManager::loadFromFile(const string& filename)
 
     User* currentUser = nullptr;
 
+    // Parse buffers reused for every line, so a task line allocates nothing
+    // beyond its node in the shard pool
+    stringstream ss;
+    string type, title, dueDate, status;
     while (getline(file, line))
     {
         // Skip empty lines
@@ -1801,8 +2988,8 @@ void UserManager::loadFromFile(const string& filename)
             continue;
         }
 
-        stringstream ss(line);
-        string type;
+        ss.clear();
+        ss.str(line);
         ss >> type;
 
         if (type == "User")
@@ -1824,31 +3011,18 @@ void UserManager::loadFromFile(const string& filename)
             bool isActive = (statusStr == "Active");
 
             // Only add user if all data is valid
-            User newUser(id, username, email, password, isActive);
-            usersById[id] = newUser;
-            usersByUsername[username] = id;
-            usersByEmail[email] = id;
-            usedUsernames.insert(username);
-            usedEmails.insert(email);
-            currentUser = &usersById[id];
-
-            // Update user counter to ensure they're correct
-            if (id >= userIdCounter)
-            {
-                userIdCounter = id + 1;
-            }
+            currentUser = restoreUser(id, username, email, password, isActive);
         }
         else if (type == "TASK" && currentUser)
         {
-            int taskId;
-            string title, dueDate, status;
+            int taskId = 0;
             ss >> taskId >> title >> dueDate >> status;
+            if (taskId <= 0) continue; // Malformed task ID - skip the line, like the parallel loader
 
             // Replace underscores back with spaces
             replace(title.begin(), title.end(), '_', ' ');
 
-            Task newTask(taskId, title, dueDate, status);
-            currentUser->tasks[taskId] = newTask;
+            restoreTask(currentUser, taskId, title, packDate(dueDate), status);
         }
         else if (line.find("Total Users:") != string::npos)
         {
@@ -1856,32 +3030,23 @@ void UserManager::loadFromFile(const string& filename)
             break;
         }
     }
+    bool readFailed = file.bad();
     file.close();
 
-    // Update task counter to ensure no conflicts with existing tasks
-    for (const auto& userPair : usersById)
+    // Next task ID after the highest one loaded - kept by the task owner index
+    if (taskOwners.highestTaskId() >= taskIdCounter)
     {
-        for (const auto& taskPair : userPair.second.tasks)
-        {
-            if (taskPair.first >= taskIdCounter)
-            {
-                taskIdCounter = taskPair.first + 1;
-            }
-        }
+        taskIdCounter = taskOwners.highestTaskId() + 1;
     }
-
-    // Update task counter after all tasks are loaded
-    for (const auto& userPair : usersById)
+#ifndef NDEBUG
+    statisticsConsistent();
+#endif
+    if (readFailed)
     {
-        for (const auto& taskPair : userPair.second.tasks)
-        {
-            if (taskPair.second.taskId >= taskIdCounter)
-            {
-                taskIdCounter = taskPair.second.taskId + 1;
-            }
-        }
+        cerr << "Error: Could not read all of data file " << filename << endl;
+        return false;
     }
-    updateStatistics();
     cout << "Data loaded successfully." << endl;
+    return true;
 }
 
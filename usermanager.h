@@ -1,93 +1,591 @@
 #ifndef USER_MANAGER_H
 #define USER_MANAGER_H
 
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstdint>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <set>
+#include <tuple>
 #include <unordered_map>
-#include <unordered_set>
 #include <vector>
 #include <string>
+#include "identityindex.h"
+#include "opmetrics.h"
+#include "snapshot.h"
+#include "taskowners.h"
+#include "trigramindex.h"
 using namespace std;
 
-// Task structure - now using unordered_map instead of linked list
+class Journal;
+class ReminderScheduler;
+class Terminal;
+struct JournalRecord;
+
+// Result codes for the headless (non-interactive) operations
+enum class OpStatus {
+    Ok,
+    UserNotFound,
+    TaskNotFound,
+    InvalidUsername,
+    InvalidEmail,
+    InvalidPassword,
+    InvalidTitle,
+    InvalidDate,
+    InvalidStatus,
+    UsernameTaken,
+    EmailTaken,
+    WrongPassword,
+    AccountInactive,
+    AlreadyCompleted,
+    NoChange,
+    IoError,
+    MalformedRow
+};
+
+// Human readable message for an OpStatus
+const char* opStatusMessage(OpStatus status);
+
+// Task structure - now using unordered_map instead of linked list.
+// Allocator-aware: inside a User's task map the title lives in the shard's pool.
 struct Task {
+    using allocator_type = pmr::polymorphic_allocator<char>;
+
     int taskId;
-    string title;
-    string dueDate;
-    string status;
+    pmr::string title;
+    uint32_t dueDate;   // Packed YYYYMMDD (dateutil.h), 0 = no date; text only for display
+    string status;      // "Ongoing" / "Completed" - always in the small-string buffer
 
     // Default constructor
-    Task() : taskId(0), status("Ongoing") {}
+    explicit Task(const allocator_type& alloc = {}) : taskId(0), title(alloc), dueDate(0), status("Ongoing") {}
 
     // Parameterized constructor
-    Task(int id, const string& t, const string& date, const string& s = "Ongoing")
+    Task(int id, const string& t, uint32_t date, const string& s = "Ongoing")
         : taskId(id), title(t), dueDate(date), status(s) {}
+    Task(int id, const string& t, uint32_t date, const string& s, const allocator_type& alloc)
+        : taskId(id), title(t, alloc), dueDate(date), status(s) {}
+
+    // Copies and moves into a container that uses another memory resource
+    Task(const Task& other) = default;
+    Task(Task&& other) = default;
+    Task(const Task& other, const allocator_type& alloc)
+        : taskId(other.taskId), title(other.title, alloc), dueDate(other.dueDate), status(other.status) {}
+    Task(Task&& other, const allocator_type& alloc)
+        : taskId(other.taskId), title(move(other.title), alloc), dueDate(other.dueDate), status(move(other.status)) {}
+    Task& operator=(const Task& other) = default;
+    Task& operator=(Task&& other) = default;
 };
 
-// User structure - using hash maps for tasks
+// Entry of the ordered due-date indexes. Ongoing tasks sort before completed
+// ones, so "overdue and still Ongoing" is one contiguous range.
+struct DueEntry {
+    bool completed;
+    uint32_t dueDate;
+    int taskId;
+    int userId;
+
+    bool operator<(const DueEntry& other) const
+    {
+        return tie(completed, dueDate, taskId) < tie(other.completed, other.dueDate, other.taskId);
+    }
+};
+
+using DueIndex = pmr::set<DueEntry>;
+
+// User structure - using hash maps for tasks.
+// Allocator-aware: inside a shard, the task map and due index use the shard's pool.
 struct User {
+    using allocator_type = pmr::polymorphic_allocator<char>;
+
     int id;
     string username;
     string email;
     string password;
     bool isActive;
-    unordered_map<int, Task> tasks;  // Hash map: taskId -> Task (O(1) access)
+    pmr::unordered_map<int, Task> tasks;  // Hash map: taskId -> Task (O(1) access)
+    int completedCount;              // Tasks with status "Completed", kept in sync by UserManager
+    DueIndex dueIndex;               // This user's tasks ordered by (status, due date)
+    bool viewDirty;                  // Changed since the last admin view was published
 
     // Default constructor
-    User() : id(0), isActive(true) {}
+    explicit User(const allocator_type& alloc = {})
+        : id(0), isActive(true), tasks(alloc), completedCount(0), dueIndex(alloc), viewDirty(false) {}
 
     // Parameterized constructor
-    User(int userId, const string& user, const string& mail, const string& pass, bool active = true)
-        : id(userId), username(user), email(mail), password(pass), isActive(active) {}
+    User(int userId, const string& user, const string& mail, const string& pass, bool active = true,
+         const allocator_type& alloc = {})
+        : id(userId), username(user), email(mail), password(pass), isActive(active),
+          tasks(alloc), completedCount(0), dueIndex(alloc), viewDirty(false) {}
+
+    // Copies and moves into a container that uses another memory resource
+    User(const User& other) = default;
+    User(User&& other) = default;
+    User(const User& other, const allocator_type& alloc)
+        : id(other.id), username(other.username), email(other.email), password(other.password),
+          isActive(other.isActive), tasks(other.tasks, alloc), completedCount(other.completedCount),
+          dueIndex(other.dueIndex, alloc), viewDirty(other.viewDirty) {}
+    User(User&& other, const allocator_type& alloc)
+        : id(other.id), username(move(other.username)), email(move(other.email)), password(move(other.password)),
+          isActive(other.isActive), tasks(move(other.tasks), alloc), completedCount(other.completedCount),
+          dueIndex(move(other.dueIndex), alloc), viewDirty(other.viewDirty) {}
+    User& operator=(const User& other) = default;
+    User& operator=(User&& other) = default;
+
+    // O(1) ongoing count - every task that is not completed
+    int ongoingCount() const { return static_cast<int>(tasks.size()) - completedCount; }
+};
+
+// Immutable copy of the fields the admin reports list for one user
+struct UserSummary {
+    int id;
+    string username;
+    string email;
+    bool isActive;
+    int taskCount;
+    int completedCount;
+};
+
+// Immutable version of the user set for the admin reports (read-copy-update).
+// Readers hold a shared_ptr and never lock; unchanged users are shared between versions.
+struct AdminView {
+    uint64_t version = 0;
+    vector<shared_ptr<const UserSummary>> users;           // Ascending ID
+    int activeUsers = 0;
+    int totalTasks = 0;
+    int completedTasks = 0;
 };
 
+// One row of a bulk user import
+struct ImportUser {
+    string username;
+    string email;
+    string password;
+    bool isActive = true;
+};
+
+// A row the import left out and why
+struct ImportRejection {
+    size_t row;                      // Index in the batch; line number for CSV files
+    OpStatus reason;
+    string value;                    // The offending username or email, or the malformed line
+    int existingUserId = 0;          // UsernameTaken / EmailTaken by an existing user
+    size_t earlierRow = SIZE_MAX;    // ... or by this earlier row of the same batch
+};
+
+// Outcome of a bulk import. Accepted rows are committed together or not at all.
+struct ImportReport {
+    OpStatus status = OpStatus::Ok;     // IoError when the CSV file could not be read
+    size_t rows = 0;
+    bool committed = false;             // False when nothing was added
+    vector<int> userIds;                // IDs of the committed rows, in row order
+    vector<ImportRejection> rejected;
+};
+
+// Which tasks a bulk task operation touches - every criterion must hold, the
+// defaults match every task. Dates are packed YYYYMMDD and inclusive; tasks
+// without a due date have date 0, so dueFrom = 1 leaves them out.
+struct TaskFilter {
+    enum class Status { Any, Ongoing, Completed };
+    Status status = Status::Any;
+    uint32_t dueFrom = 0;
+    uint32_t dueTo = UINT32_MAX;
+    vector<int> taskIds;             // Only these tasks, when not empty
+};
+
+// Keyset cursors for paging. A page ends with the key of its last row and the
+// next page starts strictly after it, so the rows already shown never repeat
+// or shift when users or tasks are added or removed between pages.
+struct UserCursor {
+    int afterId = 0;       // Users are listed in ascending ID
+    bool done = false;     // No rows after afterId when the last page was read
+};
+
+struct TaskCursor {
+    DueEntry after = { false, 0, INT_MIN, 0 };   // Tasks in due-index order: ongoing by date, then completed
+    bool done = false;
+};
+
+// Session handle: a user ID plus the generation of its slot when the handle
+// was taken. Deleting the user bumps the generation, so a handle kept across
+// the deletion (or a reuse of the ID) no longer matches.
+struct UserHandle {
+    int id = 0;
+    uint32_t generation = 0;
+};
+
+// Dense primary store of one shard's users, indexed by ID. Shard s holds the
+// IDs s, s + stride, s + 2 * stride, ..., so user id sits in slot id / stride:
+// a lookup is a bounds check and an index, and walking the slots visits the
+// shard's users in ascending ID. Slots come in fixed blocks that never move,
+// so User pointers (and the index keys viewing their strings) stay valid until
+// the user is erased. An empty slot holds a User with id 0.
+class UserSlots {
+public:
+    static const size_t BLOCK_SIZE = 256;
+
+    UserSlots(unsigned slotStride, pmr::memory_resource* resource) : stride(slotStride), memory(resource) {}
+
+    User* find(int id)
+    {
+        Slot* slot = slotOf(id);
+        return (slot && slot->user.id != 0) ? &slot->user : nullptr;
+    }
+
+    const User* find(int id) const { return const_cast<UserSlots*>(this)->find(id); }
+
+    // The user in the slot for id; an empty record when the slot was free
+    User& insert(int id)
+    {
+        size_t index = static_cast<size_t>(id) / stride;
+        size_t block = index / BLOCK_SIZE;
+        if (block >= blocks.size()) blocks.resize(block + 1);
+        if (blocks[block].empty())
+        {
+            blocks[block].reserve(BLOCK_SIZE);
+            for (size_t i = 0; i < BLOCK_SIZE; i++) blocks[block].emplace_back(memory);
+        }
+
+        Slot& slot = blocks[block][index % BLOCK_SIZE];
+        if (slot.user.id == 0) used++;
+        return slot.user;
+    }
+
+    // Empties the slot and gives it a new generation
+    void erase(int id)
+    {
+        Slot* slot = slotOf(id);
+        if (!slot || slot->user.id == 0) return;
+        slot->user = User(User::allocator_type(memory));
+        slot->generation++;
+        used--;
+    }
+
+    // Generation of the slot for id - 0 for a slot never used
+    uint32_t generation(int id) const
+    {
+        const Slot* slot = const_cast<UserSlots*>(this)->slotOf(id);
+        return slot ? slot->generation : 0;
+    }
+
+    // Size the block table for IDs below maxId; the blocks are still made on first use
+    void reserve(int maxId)
+    {
+        if (maxId > 0) blocks.reserve(static_cast<size_t>(maxId) / stride / BLOCK_SIZE + 1);
+    }
+
+    size_t size() const { return used; }
+    size_t slotCount() const { return blocks.size() * BLOCK_SIZE; }
+
+    // User in slot index, or null - slot i holds ID i * stride + shard number
+    const User* atSlot(size_t index) const
+    {
+        size_t block = index / BLOCK_SIZE;
+        if (block >= blocks.size() || blocks[block].empty()) return nullptr;
+        const User& user = blocks[block][index % BLOCK_SIZE].user;
+        return user.id != 0 ? &user : nullptr;
+    }
+
+    // Visit every user in ascending ID
+    template <typename Fn>
+    void forEach(Fn fn) const
+    {
+        for (const auto& block : blocks)
+        {
+            for (const Slot& slot : block)
+            {
+                if (slot.user.id != 0) fn(slot.user);
+            }
+        }
+    }
+
+private:
+    struct Slot {
+        User user;
+        uint32_t generation = 0;
+
+        explicit Slot(pmr::memory_resource* resource) : user(User::allocator_type(resource)) {}
+    };
+
+    unsigned stride;
+    pmr::memory_resource* memory;
+    vector<vector<Slot>> blocks;     // BLOCK_SIZE slots each, or empty until first used
+    size_t used = 0;
+
+    Slot* slotOf(int id)
+    {
+        if (id <= 0) return nullptr;
+        size_t index = static_cast<size_t>(id) / stride;
+        size_t block = index / BLOCK_SIZE;
+        if (block >= blocks.size() || blocks[block].empty()) return nullptr;
+        return &blocks[block][index % BLOCK_SIZE];
+    }
+};
+
+// One lock-striped partition of the users: a user lives in shard (id % shard count).
+// The lock guards the user records of the shard, their tasks, the shard's due index
+// and the shard's pool. The pool hands user, task and due-index nodes and task
+// titles out of large chunks and recycles freed blocks through per-size free
+// lists. Build with -DTASK_PLANNER_NO_POOLS to use plain new/delete instead.
+struct UserShard {
+    explicit UserShard(unsigned shardCount) : users(shardCount, memory()) {}
+
+    mutable mutex lock;
+#ifndef TASK_PLANNER_NO_POOLS
+    pmr::unsynchronized_pool_resource pool;                // Declared first, destroyed last
+    pmr::memory_resource* memory() { return &pool; }
+#else
+    pmr::memory_resource* memory() { return pmr::new_delete_resource(); }
+#endif
+    UserSlots users;                                       // userId -> User, slot id / shard count
+    DueIndex dueIndex{ memory() };                         // This shard's tasks ordered by (status, due date)
+    vector<int> dirtyUsers;                                // Changed or removed since the last admin view
+};
+
+// Thread safety: the headless operations below may be called from many threads.
+// Task and account operations lock only the user's shard; registration, username,
+// email and deletion also take identityLock, which guards the cross-shard indexes.
+// Lock order is identityLock, then one shard. The admin reports read an AdminView
+// and never block writers. The user portal menus, the loaders and the forEachUser
+// visitors expect a single session (no concurrent writers).
 class UserManager {
 private:
-    unordered_map<int, User> usersById;                    // Primary storage: userId -> User
-    unordered_map<string, int> usersByUsername;            // Index: username -> userId
-    unordered_map<string, int> usersByEmail;               // Index: email -> userId
-    unordered_set<string> usedUsernames;                   // Fast uniqueness check
-    unordered_set<string> usedEmails;                      // Fast email uniqueness check
+    vector<unique_ptr<UserShard>> shards;                  // Primary storage, partitioned by user ID
+
+    mutable mutex identityLock;                            // Guards the indexes below; username/email change under it and the shard lock
+    vector<int> freeUserIds;                               // IDs of deleted users, handed out again before new ones
+    IdentityIndex identities;                              // username / email -> userId, keys view the User strings
+    TrigramIndex searchIndex;                              // Substrings of ID, username and email
+
+    mutable mutex viewLock;                                // Serializes admin view rebuilds, never taken by writers
+    mutable shared_ptr<const AdminView> currentView;       // Latest published view, atomic_load/atomic_store only
 
-    int userIdCounter;      // For generating unique user IDs
-    int taskIdCounter;      // For generating unique task IDs
+    Journal* journal;       // Write-ahead journal for mutations, may be null
+    Terminal* terminal;     // Console screen of the menus, may be null
+    ReminderScheduler* reminders;  // Due-date reminders of ongoing tasks, may be null
+
+#ifndef TASK_PLANNER_NO_METRICS
+    mutable OpMetrics opMetrics;                           // Latency histogram and counters per operation
+#endif
 
-    // Statistics counters
-    int activeUsersCount;
-    int totalTasksCount;
-    int completedTasksCount;
+    atomic<int> userIdCounter;      // For generating unique user IDs
+    atomic<int> taskIdCounter;      // For generating unique task IDs
+    TaskOwnerIndex taskOwners;      // taskId -> owner for every task; updated under the owner's shard lock
+
+    // Statistics counters - updated in O(1) by every mutation
+    atomic<int> userCount;
+    atomic<int> activeUsersCount;
+    atomic<int> totalTasksCount;
+    atomic<int> completedTasksCount;
 
     // Helper methods
-    void updateStatistics();                               // Update counters
-    User* findUserById(int id);                           // O(1) user lookup
-    User* findUserByUsername(const string& username);     // O(1) user lookup
-    bool isValidEmail(const string& email);               // Email validation
+#ifndef NDEBUG
+    bool statisticsConsistent() const;                     // Debug only: full recount vs counters
+#endif
+    UserShard& shardFor(int userId) const { return *shards[static_cast<unsigned>(userId) % shards.size()]; }
+    vector<unique_lock<mutex>> lockAll() const;            // identityLock and every shard, for whole-set saves
+    void reserveUsers(size_t count);                       // Size every table for count more users
+    bool addUserLocked(const string& username, const string& email, const string& password, int* newUserId);
+    void trackTask(User* user, const Task& task, int sign);  // Counters and due-date indexes, shard locked
+    void markViewDirty(User* user);                        // Queue for the next admin view, shard locked
+    void remindTask(int userId, const Task& task);         // Schedule or cancel its reminders after a change, shard locked
+    User* findUserById(int id);                           // O(1) user lookup, caller holds the shard lock
+    User* findUserByUsername(const string& username);     // O(1) user lookup, single session only
+    static bool isValidEmail(const string& email);        // Email validation
+    static OpStatus validateNewUser(const string& username, const string& email, const string& password);
     bool isValidDate(const string& date);                 // Date validation
+    uint32_t parseDueDate(const string& date);            // Validated DD/MM/YYYY -> YYYYMMDD, 0 if invalid
+    static string searchText(const User& user);           // Text indexed by searchIndex
     int getNextTaskId();                                   // Generate unique task ID
 
+    // Persistence helpers shared by the text and binary loaders
+    User* restoreUser(int id, const string& username, const string& email, const string& password, bool isActive);
+    User* restoreUser(User&& user);
+    void restoreTask(User* user, int taskId, const string& title, uint32_t dueDate, const string& status);
+    void applyJournalRecord(const JournalRecord& record);
+    bool writeSnapshot(const string& filename, uint64_t* bytesWritten = nullptr,  // saveSnapshot body, caller holds lockAll
+                       SnapshotEncoding encoding = SnapshotEncoding::Compressed);
+    bool loadFixedSnapshot(const string& filename, uint64_t* bytesRead);    // Version 1, through a file mapping
+    bool loadCompactSnapshot(const string& filename, uint64_t* bytesRead);  // Version 2, streamed a block at a time
+    ImportReport importRows(const vector<ImportUser>& rows, bool allOrNothing, bool commitAllowed);
+    OpStatus updateTasks(int userId, const TaskFilter& filter, bool remove, size_t* count);
+    size_t applyTaskBatch(UserShard& shard, DueIndex& index, const TaskFilter& filter,
+                          const vector<int>& ids, bool remove);
+    size_t applyTaskList(UserShard& shard, const TaskFilter& filter,
+                         const vector<pair<int, int>>& tasks, bool remove);
+
+    // Console screen helpers of the menus
+    void clearScreen();
+    void showMenu(const string& frame);
+
     // User Portal helper methods
     void userDashboard(User* currentUser);
     void editProfile(User* currentUser);
     void taskManagement(User* currentUser);
+    void bulkTaskMenu(int userId);                         // Bulk task actions of one user, 0 = every user
 
 public:
-    UserManager();
+    explicit UserManager(unsigned shardCount = 1);
     ~UserManager();  // Destructor for cleanup
 
     // Admin authentication and dashboard
     bool adminLogin();
     void showAdminDashboard();
     void adminDashboardMenu();
+    void showPerformance();                               // Calls and p50 / p99 / max per operation
+    void importUsersMenu();                               // Admin CSV import screen
+    void findTaskMenu();                                  // Admin task lookup by ID alone
+
+#ifndef TASK_PLANNER_NO_METRICS
+    // Per-operation instrumentation - slow-op threshold and log, raw histograms
+    OpMetrics& metrics() const { return opMetrics; }
+#endif
 
     // User management - All O(1) operations now!
     bool addUser(const string& username, const string& email, const string& password);
     void viewAllUsers();
     void viewAllUserTasks();
     void filterUsers();
+    void showTaskAnalytics();
     void searchUsers(const string& keyword);
 
+    // Headless operations - no console input, used by menus and batch executor
+    OpStatus registerUser(const string& username, const string& email, const string& password, int* newUserId = nullptr);
+    OpStatus loginUser(const string& username, const string& password, int* userId = nullptr);
+    OpStatus setUserActive(int id, bool active);
+    OpStatus changeUsername(int userId, const string& newUsername);
+    OpStatus changeEmail(int userId, const string& newEmail);
+    OpStatus changePassword(int userId, const string& currentPassword, const string& newPassword);
+    OpStatus removeUser(int userId);
+    OpStatus createTask(int userId, const string& title, const string& dueDate, int* newTaskId = nullptr);
+    OpStatus setTaskTitle(int userId, int taskId, const string& title);
+    OpStatus setTaskDueDate(int userId, int taskId, const string& dueDate);
+    OpStatus setTaskStatus(int userId, int taskId, const string& status);
+    OpStatus completeTask(int userId, int taskId);
+    OpStatus removeTask(int userId, int taskId);
+    const User* getUser(int id) const;                    // Unsynchronized, single session only
+    OpStatus findTask(int taskId, int* ownerId = nullptr, Task* task = nullptr) const;  // Any user's task, O(1) through the task index
+    UserHandle handleOf(int id) const;                    // Generation 0 when the user does not exist
+    bool isCurrent(const UserHandle& handle) const;       // The user still exists and is the one the handle was taken for
+
+    // Bulk task operations (bulktasks.cpp) - one pass over the due-date index of
+    // the user, or of every shard for userId 0, collects the tasks that match the
+    // filter; they are changed under the same shard lock and the statistics
+    // counters move once per shard. count receives the number of tasks changed.
+    // completeTasks skips tasks that are already completed.
+    OpStatus completeTasks(int userId, const TaskFilter& filter, size_t* count = nullptr);
+    OpStatus removeTasks(int userId, const TaskFilter& filter, size_t* count = nullptr);
+
+    // Bulk import (bulkimport.cpp). Fields are validated in parallel, duplicates
+    // are found within the batch and against existing users, then every index is
+    // sized once and the accepted rows go in under all locks, so no reader sees
+    // half a batch. allOrNothing rejects the whole batch when any row is bad.
+    // CSV columns: username,email,password[,Active|Inactive], optional header line.
+    ImportReport importUsers(const vector<ImportUser>& rows, bool allOrNothing = false);
+    ImportReport importUsersCsv(const string& filename, bool allOrNothing = false);
+
+    // Current immutable admin view. Users changed since the last call are copied
+    // in (locking one shard at a time, O(changed)); the scan over the returned view
+    // holds no lock, so writers never wait on a report.
+    shared_ptr<const AdminView> adminView() const;
+
+    // Due-date queries over the ordered indexes - O(log n + k).
+    // Dates are packed YYYYMMDD and inclusive; userId 0 searches every user.
+    vector<DueEntry> findTasksDue(uint32_t from, uint32_t to, bool ongoingOnly = false,
+                                  int userId = 0, size_t limit = SIZE_MAX) const;
+    vector<DueEntry> findOverdueTasks(uint32_t today, int userId = 0, size_t limit = SIZE_MAX) const;
+
+    // Users whose ID, username or email contains keyword, best matches first
+    // (username prefix, email prefix, username, email, ID). Keywords of 3+
+    // characters use the trigram index; shorter ones scan every user.
+    vector<int> findUsersMatching(const string& keyword, size_t limit = 20, size_t* totalMatches = nullptr) const;
+
+    // Stream up to limit users after cursor.afterId to fn(const UserSummary&),
+    // from the current admin view - no lock is held while fn runs. Returns the
+    // rows visited and advances the cursor.
+    template <typename Fn>
+    size_t streamUsers(UserCursor& cursor, size_t limit, Fn fn) const
+    {
+        shared_ptr<const AdminView> view = adminView();
+        auto it = upper_bound(view->users.begin(), view->users.end(), cursor.afterId,
+                              [](int id, const shared_ptr<const UserSummary>& user) { return id < user->id; });
+        size_t count = 0;
+        for (; it != view->users.end() && count < limit; ++it, ++count)
+        {
+            fn(**it);
+            cursor.afterId = (*it)->id;
+        }
+        cursor.done = it == view->users.end();
+        return count;
+    }
+
+    // Stream up to limit of one user's tasks after the cursor to fn(const Task&)
+    // in due-index order - O(log n + limit). fn runs under the user's shard lock
+    // and must not call back into UserManager. Returns the rows visited.
+    template <typename Fn>
+    size_t streamUserTasks(int userId, TaskCursor& cursor, size_t limit, Fn fn) const
+    {
+        const UserShard& shard = shardFor(userId);
+        lock_guard<mutex> guard(shard.lock);
+        const User* found = shard.users.find(userId);
+        cursor.done = true;
+        if (!found) return 0;
+
+        const User& user = *found;
+        auto it = user.dueIndex.upper_bound(cursor.after);
+        size_t count = 0;
+        for (; it != user.dueIndex.end() && count < limit; ++it, ++count)
+        {
+            fn(user.tasks.at(it->taskId));
+            cursor.after = *it;
+        }
+        cursor.done = it == user.dueIndex.end();
+        return count;
+    }
+
+    // One page of a listing written to out as a table - the bodies of the paged
+    // viewAllUsers, viewAllUserTasks and viewUserTasks screens. limit = SIZE_MAX
+    // writes the rest of the listing in one call.
+    size_t writeUserPage(ostream& out, UserCursor& cursor, size_t limit = SIZE_MAX) const;
+    size_t writeTaskCountPage(ostream& out, UserCursor& cursor, size_t limit = SIZE_MAX) const;
+    size_t writeTaskPage(ostream& out, int userId, TaskCursor& cursor, size_t limit = SIZE_MAX) const;
+
+    // Read-only visit of every user (shard by shard, ascending ID within a shard)
+    template <typename Fn>
+    void forEachUser(Fn fn) const
+    {
+        for (const auto& shard : shards)
+        {
+            shard->users.forEach(fn);
+        }
+    }
+
+    // Read-only visit of every user in ascending ID order - one sweep over the
+    // slots, no copies, no sorting. Slot i of shard s holds ID i * shard count + s.
+    template <typename Fn>
+    void forEachUserById(Fn fn) const
+    {
+        size_t slots = 0;
+        for (const auto& shard : shards)
+        {
+            slots = max(slots, shard->users.slotCount());
+        }
+        for (size_t slot = 0; slot < slots; slot++)
+        {
+            for (const auto& shard : shards)
+            {
+                if (const User* user = shard->users.atSlot(slot)) fn(*user);
+            }
+        }
+    }
+
     // User status control - O(1) operations
     bool toggleUserActivation(int id);
-    bool isUserActiveById(int id);
+    bool isUserActiveById(int id) const;
 
     // User Portal functions
     void userPortalMenu();
@@ -107,14 +605,32 @@ public:
     void markTaskCompleted(User* currentUser);
     void deleteTask(User* currentUser);
     void viewTaskDetails(User* currentUser);
+    void viewUpcomingTasks(User* currentUser);
     Task* findTaskById(User* currentUser, int taskId);
 
-    // File persistence
-    void saveToFile(const string& filename = "data.txt");
-    void loadFromFile(const string& filename = "data.txt");
+    // File persistence - text format (export), binary snapshot (snapshot.cpp)
+    // and the multi-threaded text loader (parallelload.cpp)
+    bool saveToFile(const string& filename = "data.txt");
+    bool loadFromFile(const string& filename = "data.txt");
+    bool loadFromFileParallel(const string& filename = "data.txt", unsigned threadCount = 0);
+    bool saveSnapshot(const string& filename = "data.bin", SnapshotEncoding encoding = SnapshotEncoding::Compressed);
+    bool loadSnapshot(const string& filename = "data.bin");
+
+    // Write-ahead journal - every successful mutation is appended to it
+    void attachJournal(Journal* j) { journal = j; }
+    bool replayJournal(const string& filename);
+    bool checkpoint(const string& snapshotFile);
+
+    // Due-date reminders: attaching schedules every ongoing task with a due date
+    // (under all locks), then task changes keep the scheduler current. Null detaches.
+    void attachReminders(ReminderScheduler* scheduler);
+
+    // Interactive console - menus clear and redraw through it instead of system("cls")
+    void attachTerminal(Terminal* t) { terminal = t; }
 
     // Utility functions for statistics
-    int getTotalUsersCount() const { return usersById.size(); }
+    int getTotalUsersCount() const { return userCount; }
+    unsigned getShardCount() const { return static_cast<unsigned>(shards.size()); }
     int getActiveUsersCount() const { return activeUsersCount; }
     int getTotalTasksCount() const { return totalTasksCount; }
     int getCompletedTasksCount() const { return completedTasksCount; }